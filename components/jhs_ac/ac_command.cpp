@@ -1,33 +1,32 @@
 #include "ac_command.h"
-#include "binary_input_stream.h"
-#include "jhs_ac.h"
 
 namespace esphome::jhs_ac {
-    
-uint32_t AirConditionerCommand::calculate_checksum(const BinaryOutputStream &packet)
-{
-    uint32_t sum = 0;
-    BinaryInputStream stream(packet.get_buffer_addr(), packet.get_length());
 
-    stream.skip_bytes(1);
-    for (int32_t i = 0; i < PACKET_AC_STATE_CHECKSUM_LENGTH; i++) {
-        sum += stream.read<uint8_t>().value();
+bool AirConditionerCommand::is_applied(const AirConditionerState &state) const
+{
+    switch (function)
+    {
+        case Function::Power: return state.power == (argument != 0);
+        case Function::Mode: return state.mode == static_cast<AirConditionerState::Mode>(argument);
+        case Function::Sleep: return state.sleep == (argument != 0);
+        case Function::Temperature: return state.temperature_setting == argument;
+        case Function::Oscillation: return state.oscillation == (argument != 0);
+        case Function::FanSpeed: return state.fan_speed == static_cast<AirConditionerState::FanSpeed>(argument);
+        default: return false;
     }
-    return sum % 256;
 }
 
-void AirConditionerCommand::serialize_command(BinaryOutputStream &packet, uint8_t function_code, uint8_t argument)
+void AirConditionerCommand::apply_to(AirConditionerState &state) const
 {
-    constexpr uint32_t protocol_version = JHS_AC_PROTOCOL_VERSION;
-    packet.write<uint8_t>(PACKET_START_MARKER);
-    packet.write<uint8_t>(function_code);
-    packet.write<uint8_t>(protocol_version == 1 ? argument : 0x01);
-    packet.write<uint8_t>(argument);
-    packet.write<uint8_t>(calculate_checksum(packet));
-    packet.write<uint8_t>(PACKET_END_MARKER);
-
-    if (packet.get_length() != PACKET_AC_COMMAND_SIZE) {
-        ESP_LOGW(JhsAirConditioner::TAG, "Invalid AC command packet length");
+    switch (function)
+    {
+        case Function::Power: state.power = argument != 0; break;
+        case Function::Mode: state.mode = static_cast<AirConditionerState::Mode>(argument); break;
+        case Function::Sleep: state.sleep = argument != 0; break;
+        case Function::Temperature: state.temperature_setting = argument; break;
+        case Function::Oscillation: state.oscillation = argument != 0; break;
+        case Function::FanSpeed: state.fan_speed = static_cast<AirConditionerState::FanSpeed>(argument); break;
+        default: break;
     }
 }
 
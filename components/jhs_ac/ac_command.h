@@ -1,16 +1,17 @@
 #pragma once
-#include "binary_output_stream.h"
+#include "ac_state.h"
 #include <stdint.h>
+#include <algorithm>
+#include <type_traits>
 
 namespace esphome::jhs_ac {
 
-class AirConditionerCommand
+struct AirConditionerCommand
 {
 public:
     static constexpr uint8_t PACKET_START_MARKER = 0xA5;
     static constexpr uint8_t PACKET_END_MARKER = 0xF5;
     static constexpr uint32_t PACKET_AC_COMMAND_SIZE = 6;
-    static constexpr uint32_t PACKET_AC_STATE_CHECKSUM_LENGTH = 3;
 
     enum class Function : uint8_t
     {
@@ -22,13 +23,47 @@ public:
         FanSpeed = 0x16
     };
 
-    uint32_t calculate_checksum(const BinaryOutputStream &packet);
-    virtual void write_to_packet(BinaryOutputStream &packet) = 0;
+    static constexpr AirConditionerCommand power(bool status) 
+    { 
+        return {Function::Power, static_cast<uint8_t>(status ? 0x1 : 0x0)}; 
+    }
 
-protected:
-    void serialize_command(BinaryOutputStream &packet, uint8_t function_code, uint8_t argument);
+    static constexpr AirConditionerCommand mode(AirConditionerState::Mode mode) 
+    { 
+        return {Function::Mode, static_cast<uint8_t>(mode)}; 
+    }
+
+    static constexpr AirConditionerCommand sleep(bool status) 
+    { 
+        return {Function::Sleep, static_cast<uint8_t>(status ? 0x1 : 0x0)}; 
+    }
+
+    static constexpr AirConditionerCommand temperature(int32_t value) 
+    { 
+        // values out of byte range are clamped, so they stay invalid for AC
+        return {Function::Temperature, static_cast<uint8_t>(std::clamp<int32_t>(value, 0, UINT8_MAX))}; 
+    }
+
+    static constexpr AirConditionerCommand oscillation(bool status) 
+    { 
+        return {Function::Oscillation, static_cast<uint8_t>(status ? 0x1 : 0x0)}; 
+    }
+
+    static constexpr AirConditionerCommand fan_speed(AirConditionerState::FanSpeed speed) 
+    { 
+        return {Function::FanSpeed, static_cast<uint8_t>(speed)}; 
+    }
+
+    bool is_applied(const AirConditionerState &state) const;
+    // changes state the way AC would after applying this command
+    void apply_to(AirConditionerState &state) const;
+
+    Function function;
+    uint8_t argument;
 };
 
 static_assert(sizeof(AirConditionerCommand::Function) == sizeof(uint8_t), "Enumeration should have single byte size.");
+static_assert(std::is_trivially_copyable_v<AirConditionerCommand>, "Command should be plain value type.");
+static_assert(sizeof(AirConditionerCommand) == 2, "Command should consist only of function and argument.");
 
 } // namespace esphome::jhs_ac
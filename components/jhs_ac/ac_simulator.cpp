@@ -0,0 +1,162 @@
+#include "ac_simulator.h"
+#include "ac_state_view.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome::jhs_ac {
+
+AirConditionerSimulator::AirConditionerSimulator() :
+    m_state{},
+    m_protocol_version(1),
+    m_reaction_delay(300),
+    m_report_interval(1000),
+    m_last_report_time(0),
+    m_drop_probability(0.0f),
+    m_bit_flip_probability(0.0f),
+    m_partial_frame_probability(0.0f),
+    m_random_state(0x2545F491)
+{
+    m_state.mode = AirConditionerState::Mode::Cool;
+    m_state.fan_speed = AirConditionerState::FanSpeed::Low;
+    m_state.temperature_ambient = 26;
+    m_state.temperature_setting = 24;
+    m_state.temperature_unit = AirConditionerState::TemperatureUnit::Celsius;
+    m_state.water_tank_state = AirConditionerState::WaterTankState::Empty;
+}
+
+void AirConditionerSimulator::write(const uint8_t *data, uint32_t length, uint32_t current_time)
+{
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if (m_command_buffer.size() == 0 && data[i] != AirConditionerCommand::PACKET_START_MARKER) {
+            continue;
+        }
+        m_command_buffer.push_back(data[i]);
+        if (m_command_buffer.size() == AirConditionerCommand::PACKET_AC_COMMAND_SIZE) {
+            process_command_frame(current_time);
+        }
+    }
+}
+
+void AirConditionerSimulator::update(uint32_t current_time)
+{
+    while (!m_pending_commands.is_empty() && 
+        static_cast<int32_t>(current_time - m_pending_commands.front().apply_time) >= 0) 
+    {
+        m_pending_commands.pop()->command.apply_to(m_state);
+    }
+
+    if (current_time - m_last_report_time >= m_report_interval)
+    {
+        m_last_report_time = current_time;
+        send_state_report();
+    }
+}
+
+uint32_t AirConditionerSimulator::read(uint8_t *data, uint32_t length)
+{
+    uint32_t count = 0;
+    while (count < length && !m_output.is_empty())
+    {
+        auto span = m_output.read_span();
+        const uint32_t chunk = std::min(length - count, span.length);
+        std::memcpy(data + count, span.data, chunk);
+        m_output.consume(chunk);
+        count += chunk;
+    }
+    return count;
+}
+
+void AirConditionerSimulator::process_command_frame(uint32_t current_time)
+{
+    const uint8_t *frame = m_command_buffer.data();
+    const uint8_t function_code = frame[1];
+    const uint8_t version_byte = frame[2];
+    const uint8_t argument = frame[3];
+    const bool end_marker_valid = frame[AirConditionerCommand::PACKET_AC_COMMAND_SIZE - 1] == AirConditionerCommand::PACKET_END_MARKER;
+    const bool checksum_valid = frame[4] == static_cast<uint8_t>(function_code + version_byte + argument);
+
+    if (!end_marker_valid || !checksum_valid)
+    {
+        // frame may begin at one of collected bytes, so rescan them
+        uint8_t data[AirConditionerCommand::PACKET_AC_COMMAND_SIZE - 1];
+        std::memcpy(data, frame + 1, sizeof(data));
+        m_command_buffer.clear();
+        write(data, sizeof(data), current_time);
+        return;
+    }
+
+    // unit ignores frames encoded for another protocol version
+    const bool version_matches = (m_protocol_version == 1) ? version_byte == argument : version_byte == 0x01;
+    if (version_matches && !m_pending_commands.is_full()) 
+    {
+        const AirConditionerCommand command = {static_cast<AirConditionerCommand::Function>(function_code), argument};
+        m_pending_commands.push(PendingCommand{command, current_time + m_reaction_delay});
+    }
+    m_command_buffer.clear();
+}
+
+void AirConditionerSimulator::encode_state_report(const AirConditionerState &state, uint8_t *packet)
+{
+    std::fill_n(packet, AirConditionerStateView::PACKET_SIZE, 0);
+    packet[0] = AirConditionerCommand::PACKET_START_MARKER;
+    packet[AirConditionerStateView::OFFSET_POWER] = state.power ? 0x1 : 0x0;
+    packet[AirConditionerStateView::OFFSET_MODE] = static_cast<uint8_t>(state.mode);
+    packet[AirConditionerStateView::OFFSET_SLEEP] = state.sleep ? 0x1 : 0x0;
+    packet[AirConditionerStateView::OFFSET_TEMPERATURE_AMBIENT] = state.temperature_ambient;
+    packet[AirConditionerStateView::OFFSET_TEMPERATURE_SETTING] = state.temperature_setting;
+    packet[AirConditionerStateView::OFFSET_OSCILLATION] = state.oscillation ? 0x1 : 0x0;
+    packet[AirConditionerStateView::OFFSET_FAN_SPEED] = static_cast<uint8_t>(state.fan_speed);
+    packet[0x0A] = state.byte_0A;
+    packet[0x0B] = state.byte_0B;
+    packet[0x0C] = state.byte_0C;
+    packet[0x0D] = state.byte_0D;
+    packet[AirConditionerStateView::OFFSET_TEMPERATURE_UNIT] = static_cast<uint8_t>(state.temperature_unit);
+    packet[AirConditionerStateView::OFFSET_WATER_TANK_STATE] = static_cast<uint8_t>(state.water_tank_state);
+
+    uint32_t sum = 0;
+    for (uint32_t i = 1; i < AirConditionerStateView::OFFSET_CHECKSUM; i++) {
+        sum += packet[i];
+    }
+    packet[AirConditionerStateView::OFFSET_CHECKSUM] = sum % 256;
+    packet[AirConditionerStateView::PACKET_SIZE - 1] = AirConditionerCommand::PACKET_END_MARKER;
+}
+
+void AirConditionerSimulator::send_state_report()
+{
+    if (random_event(m_drop_probability)) {
+        return;
+    }
+
+    uint8_t packet[AirConditionerStateView::PACKET_SIZE];
+    encode_state_report(m_state, packet);
+
+    if (random_event(m_bit_flip_probability)) {
+        packet[random_number() % sizeof(packet)] ^= 1 << (random_number() % 8);
+    }
+
+    uint32_t length = sizeof(packet);
+    if (random_event(m_partial_frame_probability)) {
+        length = 1 + random_number() % (sizeof(packet) - 1);
+    }
+
+    for (uint32_t i = 0; i < length && !m_output.is_full(); i++) {
+        m_output.push(packet[i]);
+    }
+}
+
+bool AirConditionerSimulator::random_event(float probability)
+{
+    return probability > 0.0f && (random_number() % 10000) < probability * 10000.0f;
+}
+
+uint32_t AirConditionerSimulator::random_number()
+{
+    // xorshift32, deterministic to make simulated sessions reproducible
+    m_random_state ^= m_random_state << 13;
+    m_random_state ^= m_random_state >> 17;
+    m_random_state ^= m_random_state << 5;
+    return m_random_state;
+}
+
+} // namespace esphome::jhs_ac
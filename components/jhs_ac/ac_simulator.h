@@ -0,0 +1,62 @@
+#pragma once
+#include "ac_command.h"
+#include "ac_state.h"
+#include "ring_buffer.h"
+#include "fixed_vector.h"
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+// Virtual JHS unit which accepts command frames and periodically reports its state,
+// as real AC main board does. Used instead of UART to exercise component without AC.
+class AirConditionerSimulator
+{
+public:
+    AirConditionerSimulator();
+
+    void set_protocol_version(uint32_t version) { m_protocol_version = version; }
+    void set_reaction_delay(uint32_t delay_ms) { m_reaction_delay = delay_ms; }
+    void set_report_interval(uint32_t interval_ms) { m_report_interval = interval_ms; }
+    void set_drop_probability(float probability) { m_drop_probability = probability; }
+    void set_bit_flip_probability(float probability) { m_bit_flip_probability = probability; }
+    void set_partial_frame_probability(float probability) { m_partial_frame_probability = probability; }
+
+    void write(const uint8_t *data, uint32_t length, uint32_t current_time);
+    void update(uint32_t current_time);
+    uint32_t available() const { return m_output.size(); }
+    uint32_t read(uint8_t *data, uint32_t length);
+
+    uint32_t get_protocol_version() const { return m_protocol_version; }
+    uint32_t get_reaction_delay() const { return m_reaction_delay; }
+    uint32_t get_report_interval() const { return m_report_interval; }
+
+    // writes state report frame of AirConditionerStateView::PACKET_SIZE bytes, as AC main board sends it
+    static void encode_state_report(const AirConditionerState &state, uint8_t *packet);
+
+private:
+    struct PendingCommand
+    {
+        AirConditionerCommand command;
+        uint32_t apply_time;
+    };
+
+    void process_command_frame(uint32_t current_time);
+    void send_state_report();
+    bool random_event(float probability);
+    uint32_t random_number();
+
+    AirConditionerState m_state;
+    uint32_t m_protocol_version;
+    uint32_t m_reaction_delay;
+    uint32_t m_report_interval;
+    uint32_t m_last_report_time;
+    float m_drop_probability;
+    float m_bit_flip_probability;
+    float m_partial_frame_probability;
+    uint32_t m_random_state;
+    FixedVector<uint8_t, AirConditionerCommand::PACKET_AC_COMMAND_SIZE> m_command_buffer;
+    RingBuffer<PendingCommand, 8> m_pending_commands;
+    RingBuffer<uint8_t, 128> m_output;
+};
+
+} // namespace esphome::jhs_ac
@@ -1,7 +1,24 @@
 #include "ac_state.h"
+#include <cstdarg>
+#include <cstdio>
 
 namespace esphome::jhs_ac {
 
+static void append_field(char *buffer, uint32_t size, uint32_t &length, const char *format, ...)
+{
+    if (length >= size) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    const int written = vsnprintf(buffer + length, size - length, format, args);
+    va_end(args);
+    if (written > 0) {
+        length += static_cast<uint32_t>(written);
+    }
+}
+
 const char *AirConditionerState::get_mode_name(Mode mode)
 {
     switch (mode)
@@ -14,24 +31,88 @@ const char *AirConditionerState::get_mode_name(Mode mode)
     }
 }
 
-void AirConditionerState::read_from_packet(BinaryInputStream &stream, uint32_t &checksum)
+const char *AirConditionerState::get_fan_speed_name(FanSpeed fan_speed)
+{
+    switch (fan_speed)
+    {
+        case FanSpeed::Low: return "Low";
+        case FanSpeed::Medium: return "Medium";
+        case FanSpeed::High: return "High";
+        default: return "Unknown";
+    }
+}
+
+bool AirConditionerState::has_same_climate_settings(const AirConditionerState &other) const
+{
+    return power == other.power &&
+        mode == other.mode &&
+        sleep == other.sleep &&
+        oscillation == other.oscillation &&
+        temperature_ambient == other.temperature_ambient &&
+        temperature_setting == other.temperature_setting &&
+        fan_speed == other.fan_speed;
+}
+
+bool AirConditionerState::has_same_persistent_settings(const AirConditionerState &other) const
+{
+    return power == other.power &&
+        mode == other.mode &&
+        sleep == other.sleep &&
+        oscillation == other.oscillation &&
+        temperature_setting == other.temperature_setting &&
+        fan_speed == other.fan_speed &&
+        temperature_unit == other.temperature_unit;
+}
+
+uint32_t AirConditionerState::format(const AirConditionerState *previous, char *buffer, uint32_t size) const
 {
-    stream.skip_bytes(3); // skip packet start marker and 2 blank bytes
-    this->power = stream.read<uint8_t>().value();
-    this->mode = stream.read<Mode>().value();
-    this->sleep = stream.read<uint8_t>().value();
-    this->temperature_ambient = stream.read<uint8_t>().value();
-    this->temperature_setting = stream.read<uint8_t>().value();
-    this->oscillation = stream.read<uint8_t>().value();
-    this->fan_speed = stream.read<FanSpeed>().value();
-    this->byte_0A = stream.read<uint8_t>().value();
-    this->byte_0B = stream.read<uint8_t>().value();
-    this->byte_0C = stream.read<uint8_t>().value();
-    this->byte_0D = stream.read<uint8_t>().value();
-    this->temperature_unit = stream.read<TemperatureUnit>().value();
-    this->water_tank_state = stream.read<WaterTankState>().value();
-    checksum = stream.read<uint8_t>().value();
-    stream.skip_bytes(1); // skip packet end marker
+    if (size == 0) {
+        return 0;
+    }
+
+    uint32_t length = 0;
+    buffer[0] = '\0';
+
+    if (!previous || power != previous->power) {
+        append_field(buffer, size, length, " power=%s", power ? "on" : "off");
+    }
+    if (!previous || mode != previous->mode) {
+        append_field(buffer, size, length, " mode=%s", get_mode_name(mode));
+    }
+    if (!previous || sleep != previous->sleep) {
+        append_field(buffer, size, length, " sleep=%s", sleep ? "on" : "off");
+    }
+    if (!previous || oscillation != previous->oscillation) {
+        append_field(buffer, size, length, " oscillation=%s", oscillation ? "on" : "off");
+    }
+    if (!previous || temperature_ambient != previous->temperature_ambient) {
+        append_field(buffer, size, length, " ambient=%u", temperature_ambient);
+    }
+    if (!previous || temperature_setting != previous->temperature_setting) {
+        append_field(buffer, size, length, " setting=%u", temperature_setting);
+    }
+    if (!previous || fan_speed != previous->fan_speed) {
+        append_field(buffer, size, length, " fan=%s", get_fan_speed_name(fan_speed));
+    }
+    if (!previous || temperature_unit != previous->temperature_unit) {
+        append_field(buffer, size, length, " unit=%s", temperature_unit == TemperatureUnit::Celsius ? "C" : "F");
+    }
+    if (!previous || water_tank_state != previous->water_tank_state) {
+        append_field(buffer, size, length, " tank=%s", water_tank_state == WaterTankState::Full ? "full" : "empty");
+    }
+    if (!previous || byte_0A != previous->byte_0A) {
+        append_field(buffer, size, length, " [0A]=%02X", byte_0A);
+    }
+    if (!previous || byte_0B != previous->byte_0B) {
+        append_field(buffer, size, length, " [0B]=%02X", byte_0B);
+    }
+    if (!previous || byte_0C != previous->byte_0C) {
+        append_field(buffer, size, length, " [0C]=%02X", byte_0C);
+    }
+    if (!previous || byte_0D != previous->byte_0D) {
+        append_field(buffer, size, length, " [0D]=%02X", byte_0D);
+    }
+    return length < size ? length : size - 1;
 }
 
 } // namespace esphome::jhs_ac
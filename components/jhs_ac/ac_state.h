@@ -1,5 +1,4 @@
 #pragma once
-#include "binary_input_stream.h"
 #include <stdint.h>
 
 namespace esphome::jhs_ac {
@@ -34,8 +33,13 @@ public:
         Full = 0x3
     };
 
-    void read_from_packet(BinaryInputStream &stream, uint32_t &checksum);
     static const char *get_mode_name(Mode mode);
+    static const char *get_fan_speed_name(FanSpeed fan_speed);
+    bool has_same_climate_settings(const AirConditionerState &other) const;
+    // ambient temperature, water tank state and unknown bytes are not compared, as they change on their own
+    bool has_same_persistent_settings(const AirConditionerState &other) const;
+    // writes single line of fields which differ from previous state, or all of them without one
+    uint32_t format(const AirConditionerState *previous, char *buffer, uint32_t size) const;
 
     bool power;
     bool sleep;
@@ -0,0 +1,78 @@
+#pragma once
+#include "ac_state.h"
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+// reads AC state fields directly from received packet bytes, without copying them
+class AirConditionerStateView
+{
+public:
+    // packet starts with start marker and 2 blank bytes, ends with checksum and end marker
+    static constexpr uint32_t PACKET_SIZE = 18;
+    static constexpr uint32_t OFFSET_POWER = 0x03;
+    static constexpr uint32_t OFFSET_MODE = 0x04;
+    static constexpr uint32_t OFFSET_SLEEP = 0x05;
+    static constexpr uint32_t OFFSET_TEMPERATURE_AMBIENT = 0x06;
+    static constexpr uint32_t OFFSET_TEMPERATURE_SETTING = 0x07;
+    static constexpr uint32_t OFFSET_OSCILLATION = 0x08;
+    static constexpr uint32_t OFFSET_FAN_SPEED = 0x09;
+    static constexpr uint32_t OFFSET_TEMPERATURE_UNIT = 0x0E;
+    static constexpr uint32_t OFFSET_WATER_TANK_STATE = 0x0F;
+    static constexpr uint32_t OFFSET_CHECKSUM = 0x10;
+
+    explicit AirConditionerStateView(const uint8_t *packet) : m_data(packet) {}
+
+    bool power() const { return m_data[OFFSET_POWER] != 0; }
+    bool sleep() const { return m_data[OFFSET_SLEEP] != 0; }
+    bool oscillation() const { return m_data[OFFSET_OSCILLATION] != 0; }
+    uint32_t temperature_ambient() const { return m_data[OFFSET_TEMPERATURE_AMBIENT]; }
+    uint32_t temperature_setting() const { return m_data[OFFSET_TEMPERATURE_SETTING]; }
+    AirConditionerState::Mode mode() const { return static_cast<AirConditionerState::Mode>(m_data[OFFSET_MODE]); }
+    AirConditionerState::FanSpeed fan_speed() const { return static_cast<AirConditionerState::FanSpeed>(m_data[OFFSET_FAN_SPEED]); }
+    AirConditionerState::TemperatureUnit temperature_unit() const { return static_cast<AirConditionerState::TemperatureUnit>(m_data[OFFSET_TEMPERATURE_UNIT]); }
+    AirConditionerState::WaterTankState water_tank_state() const { return static_cast<AirConditionerState::WaterTankState>(m_data[OFFSET_WATER_TANK_STATE]); }
+    uint8_t byte_0A() const { return m_data[0x0A]; }
+    uint8_t byte_0B() const { return m_data[0x0B]; }
+    uint8_t byte_0C() const { return m_data[0x0C]; }
+    uint8_t byte_0D() const { return m_data[0x0D]; }
+
+    bool differs_from(const AirConditionerState &state) const
+    {
+        return state.power != power() ||
+            state.mode != mode() ||
+            state.sleep != sleep() ||
+            state.temperature_ambient != temperature_ambient() ||
+            state.temperature_setting != temperature_setting() ||
+            state.oscillation != oscillation() ||
+            state.fan_speed != fan_speed() ||
+            state.byte_0A != byte_0A() ||
+            state.byte_0B != byte_0B() ||
+            state.byte_0C != byte_0C() ||
+            state.byte_0D != byte_0D() ||
+            state.temperature_unit != temperature_unit() ||
+            state.water_tank_state != water_tank_state();
+    }
+
+    void decode(AirConditionerState &state) const
+    {
+        state.power = power();
+        state.mode = mode();
+        state.sleep = sleep();
+        state.temperature_ambient = temperature_ambient();
+        state.temperature_setting = temperature_setting();
+        state.oscillation = oscillation();
+        state.fan_speed = fan_speed();
+        state.byte_0A = byte_0A();
+        state.byte_0B = byte_0B();
+        state.byte_0C = byte_0C();
+        state.byte_0D = byte_0D();
+        state.temperature_unit = temperature_unit();
+        state.water_tank_state = water_tank_state();
+    }
+
+private:
+    const uint8_t *m_data;
+};
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,55 @@
+#pragma once
+#include "esphome/core/automation.h"
+#include "esphome/core/helpers.h"
+#include "jhs_ac.h"
+#include <vector>
+
+namespace esphome::jhs_ac {
+
+#ifdef USE_JHS_AC_CAPTURE
+template<typename... Ts> class CaptureStartAction : public Action<Ts...>, public Parented<JhsAirConditioner>
+{
+public:
+    void play(const Ts &...x) override { this->parent_->start_capture(); }
+};
+
+template<typename... Ts> class CaptureStopAction : public Action<Ts...>, public Parented<JhsAirConditioner>
+{
+public:
+    void play(const Ts &...x) override { this->parent_->stop_capture(); }
+};
+
+template<typename... Ts> class CaptureDumpAction : public Action<Ts...>, public Parented<JhsAirConditioner>
+{
+public:
+    void play(const Ts &...x) override { this->parent_->dump_capture(); }
+};
+
+template<typename... Ts> class CaptureReplayAction : public Action<Ts...>, public Parented<JhsAirConditioner>
+{
+public:
+    void set_data(const std::vector<uint8_t> &data) { m_data = data; }
+    void set_speed(ReplaySpeed speed) { m_speed = speed; }
+    void play(const Ts &...x) override { this->parent_->start_replay(m_data, m_speed); }
+
+private:
+    std::vector<uint8_t> m_data;
+    ReplaySpeed m_speed{ReplaySpeed::Original};
+};
+#endif
+
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+template<typename... Ts> class FlightRecorderDumpAction : public Action<Ts...>, public Parented<JhsAirConditioner>
+{
+public:
+    void play(const Ts &...x) override { this->parent_->dump_flight_recorder(); }
+};
+#endif
+
+template<typename... Ts> class LatencyResetAction : public Action<Ts...>, public Parented<JhsAirConditioner>
+{
+public:
+    void play(const Ts &...x) override { this->parent_->reset_latency_histograms(); }
+};
+
+} // namespace esphome::jhs_ac
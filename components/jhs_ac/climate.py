@@ -1,9 +1,19 @@
 import esphome.config_validation as cv
 import esphome.codegen as cg
+from esphome import automation
+from esphome.core import CORE
 
-from esphome.components import climate, uart, binary_sensor
+from esphome.components import climate, uart, binary_sensor, sensor
 from esphome.const import (
-    CONF_ID
+    CONF_ID,
+    CONF_OPTIMISTIC,
+    CONF_UPDATE_INTERVAL,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
+    CONF_DATA,
+    CONF_SPEED,
 )
 from esphome.components.climate import (
     validate_climate_fan_mode,
@@ -13,13 +23,57 @@ from esphome.components.climate import (
 
 CODEOWNERS = ["@SNMetamorph"]
 DEPENDENCIES = ["climate", "uart"]
-AUTO_LOAD = ["binary_sensor"]
+AUTO_LOAD = ["binary_sensor", "sensor"]
 
 CONF_PROTOCOL_VERSION = "protocol_version"
 CONF_SUPPORTED_MODES = "supported_modes"
 CONF_SUPPORTED_FAN_MODES = "supported_fan_modes"
 CONF_SUPPORTED_SWING_MODES = "supported_swing_modes"
 
+CONF_STATE_HEARTBEAT = "state_heartbeat"
+CONF_PERSIST_STATE = "persist_state"
+CONF_STATE_SAVE_DELAY = "state_save_delay"
+CONF_OPTIMISTIC_TIMEOUT = "optimistic_timeout"
+CONF_TX_PACING = "tx_pacing"
+CONF_COMMAND_TIMEOUT = "command_timeout"
+CONF_COMMAND_RETRIES = "command_retries"
+CONF_RX_TASK = "rx_task"
+CONF_LOOP_BUDGET = "loop_budget"
+CONF_MAX_BYTES = "max_bytes"
+CONF_MAX_FRAMES = "max_frames"
+CONF_MAX_TIME = "max_time"
+CONF_PROFILE_PIPELINE = "profile_pipeline"
+CONF_SIMULATOR = "simulator"
+CONF_REACTION_DELAY = "reaction_delay"
+CONF_REPORT_INTERVAL = "report_interval"
+CONF_DROP_PROBABILITY = "drop_probability"
+CONF_BIT_FLIP_PROBABILITY = "bit_flip_probability"
+CONF_PARTIAL_FRAME_PROBABILITY = "partial_frame_probability"
+CONF_STATE_LOG_MODE = "state_log_mode"
+CONF_STATE_LOG_LEVEL = "state_log_level"
+CONF_CAPTURE_BUFFER_SIZE = "capture_buffer_size"
+CONF_FLIGHT_RECORDER_SIZE = "flight_recorder_size"
+
+CONF_DIAGNOSTICS = "diagnostics"
+CONF_BYTES_RECEIVED = "bytes_received"
+CONF_FRAMES_PARSED = "frames_parsed"
+CONF_CHECKSUM_ERRORS = "checksum_errors"
+CONF_RESYNCS = "resyncs"
+CONF_DISCARDED_BYTES = "discarded_bytes"
+CONF_RX_BUFFER_HIGH_WATER = "rx_buffer_high_water"
+CONF_RX_BUFFER_OVERFLOWS = "rx_buffer_overflows"
+CONF_TX_QUEUE_HIGH_WATER = "tx_queue_high_water"
+CONF_TX_QUEUE_DROPS = "tx_queue_drops"
+CONF_MAX_LOOP_DURATION = "max_loop_duration"
+CONF_OPTIMISTIC_ROLLBACKS = "optimistic_rollbacks"
+CONF_CONTROL_LATENCY = "control_latency"
+CONF_QUEUE_WAIT = "queue_wait"
+CONF_DELIVERY_LATENCY = "delivery_latency"
+CONF_FRAME_INTERVAL = "frame_interval"
+CONF_P50 = "p50"
+CONF_P95 = "p95"
+CONF_MAX = "max"
+
 CONF_WATER_TANK_STATUS = "water_tank_status"
 ICON_WATER_TANK_STATUS = "mdi:water-alert"
 
@@ -28,13 +82,164 @@ JhsAirConditioner = jhs_ac_ns.class_(
     "JhsAirConditioner", climate.Climate, uart.UARTDevice, cg.Component
 )
 
+AirConditionerSimulator = jhs_ac_ns.class_("AirConditionerSimulator")
+DiagnosticCounters = jhs_ac_ns.class_("DiagnosticCounters")
+Counter = DiagnosticCounters.enum("Counter", is_class=True)
+LatencyHistogram = jhs_ac_ns.class_("LatencyHistogram")
+Statistic = LatencyHistogram.enum("Statistic", is_class=True)
+LatencyMetric = jhs_ac_ns.enum("LatencyMetric", is_class=True)
+
+CaptureStartAction = jhs_ac_ns.class_("CaptureStartAction", automation.Action)
+CaptureStopAction = jhs_ac_ns.class_("CaptureStopAction", automation.Action)
+CaptureDumpAction = jhs_ac_ns.class_("CaptureDumpAction", automation.Action)
+CaptureReplayAction = jhs_ac_ns.class_("CaptureReplayAction", automation.Action)
+FlightRecorderDumpAction = jhs_ac_ns.class_("FlightRecorderDumpAction", automation.Action)
+LatencyResetAction = jhs_ac_ns.class_("LatencyResetAction", automation.Action)
+
+ReplaySpeed = jhs_ac_ns.enum("ReplaySpeed", is_class=True)
+REPLAY_SPEED_OPTIONS = {
+    "ORIGINAL": ReplaySpeed.Original,
+    "MAXIMUM": ReplaySpeed.Maximum,
+}
+
+TxPacing = jhs_ac_ns.enum("TxPacing", is_class=True)
+TX_PACING_OPTIONS = {
+    "FIXED": TxPacing.Fixed,
+    "ADAPTIVE": TxPacing.Adaptive,
+}
+
+StateLogMode = jhs_ac_ns.enum("StateLogMode", is_class=True)
+STATE_LOG_MODE_OPTIONS = {
+    "FULL": StateLogMode.Full,
+    "CHANGES": StateLogMode.Changes,
+}
+
+STATE_LOG_LEVELS = {
+    "NONE": cg.global_ns.ESPHOME_LOG_LEVEL_NONE,
+    "ERROR": cg.global_ns.ESPHOME_LOG_LEVEL_ERROR,
+    "WARN": cg.global_ns.ESPHOME_LOG_LEVEL_WARN,
+    "INFO": cg.global_ns.ESPHOME_LOG_LEVEL_INFO,
+    "DEBUG": cg.global_ns.ESPHOME_LOG_LEVEL_DEBUG,
+    "VERBOSE": cg.global_ns.ESPHOME_LOG_LEVEL_VERBOSE,
+    "VERY_VERBOSE": cg.global_ns.ESPHOME_LOG_LEVEL_VERY_VERBOSE,
+}
+
+PROTOCOL_VERSION_AUTO = 0
+
+def validate_protocol_version(value):
+    if isinstance(value, str) and value.upper() == "AUTO":
+        return PROTOCOL_VERSION_AUTO
+    return cv.int_range(1, 2)(value)
+
+def validate_rx_task(value):
+    value = cv.boolean(value)
+    if value and not CORE.is_esp32:
+        raise cv.Invalid("UART reader task is supported only on ESP32")
+    return value
+
+LOOP_BUDGET_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_MAX_BYTES, default=0): cv.int_range(0, 65535),
+        cv.Optional(CONF_MAX_FRAMES, default=4): cv.int_range(0, 255),
+        cv.Optional(CONF_MAX_TIME, default="0us"): cv.positive_time_period_microseconds,
+    }
+)
+
+SIMULATOR_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(AirConditionerSimulator),
+        cv.Optional(CONF_PROTOCOL_VERSION): cv.int_range(1, 2),
+        cv.Optional(CONF_REACTION_DELAY, default="300ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_REPORT_INTERVAL, default="1s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_DROP_PROBABILITY, default="0%"): cv.percentage,
+        cv.Optional(CONF_BIT_FLIP_PROBABILITY, default="0%"): cv.percentage,
+        cv.Optional(CONF_PARTIAL_FRAME_PROBABILITY, default="0%"): cv.percentage,
+    }
+)
+
+def counter_sensor_schema(icon, unit_of_measurement=None, state_class=STATE_CLASS_TOTAL_INCREASING):
+    return sensor.sensor_schema(
+        icon=icon,
+        unit_of_measurement=unit_of_measurement,
+        accuracy_decimals=0,
+        state_class=state_class,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+COUNTER_SENSORS = {
+    CONF_BYTES_RECEIVED: (Counter.BytesReceived, counter_sensor_schema("mdi:download", "B")),
+    CONF_FRAMES_PARSED: (Counter.FramesParsed, counter_sensor_schema("mdi:package-down")),
+    CONF_CHECKSUM_ERRORS: (Counter.ChecksumErrors, counter_sensor_schema("mdi:alert-circle-outline")),
+    CONF_RESYNCS: (Counter.Resyncs, counter_sensor_schema("mdi:sync-alert")),
+    CONF_DISCARDED_BYTES: (Counter.DiscardedBytes, counter_sensor_schema("mdi:delete-outline", "B")),
+    CONF_RX_BUFFER_HIGH_WATER: (Counter.RxBufferHighWater, counter_sensor_schema("mdi:tray-full", "B", STATE_CLASS_MEASUREMENT)),
+    CONF_RX_BUFFER_OVERFLOWS: (Counter.RxBufferOverflows, counter_sensor_schema("mdi:tray-alert")),
+    CONF_TX_QUEUE_HIGH_WATER: (Counter.TxQueueHighWater, counter_sensor_schema("mdi:tray-full", None, STATE_CLASS_MEASUREMENT)),
+    CONF_TX_QUEUE_DROPS: (Counter.TxQueueDrops, counter_sensor_schema("mdi:tray-remove")),
+    CONF_COMMAND_RETRIES: (Counter.CommandRetries, counter_sensor_schema("mdi:repeat")),
+    CONF_MAX_LOOP_DURATION: (Counter.MaxLoopDuration, counter_sensor_schema("mdi:timer-alert-outline", "µs", STATE_CLASS_MEASUREMENT)),
+    CONF_OPTIMISTIC_ROLLBACKS: (Counter.OptimisticRollbacks, counter_sensor_schema("mdi:undo-variant")),
+}
+
+LATENCY_METRICS = {
+    CONF_CONTROL_LATENCY: LatencyMetric.ControlToConfirm,
+    CONF_QUEUE_WAIT: LatencyMetric.QueueWait,
+    CONF_DELIVERY_LATENCY: LatencyMetric.Delivery,
+    CONF_FRAME_INTERVAL: LatencyMetric.FrameInterval,
+}
+
+LATENCY_STATISTICS = {
+    CONF_P50: Statistic.P50,
+    CONF_P95: Statistic.P95,
+    CONF_MAX: Statistic.Max,
+}
+
+LATENCY_SENSOR_SCHEMA = sensor.sensor_schema(
+    icon="mdi:timer-outline",
+    unit_of_measurement=UNIT_MILLISECOND,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+LATENCY_SCHEMA = cv.Schema(
+    {cv.Optional(key): LATENCY_SENSOR_SCHEMA for key in LATENCY_STATISTICS}
+)
+
+DIAGNOSTICS_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_UPDATE_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+    }
+).extend(
+    {cv.Optional(key): schema for key, (_, schema) in COUNTER_SENSORS.items()}
+).extend(
+    {cv.Optional(key): LATENCY_SCHEMA for key in LATENCY_METRICS}
+)
+
 CONFIG_SCHEMA = cv.All(
     climate.climate_schema(JhsAirConditioner).extend(
         {
-            cv.Required(CONF_PROTOCOL_VERSION): cv.int_range(1, 2),
+            cv.Required(CONF_PROTOCOL_VERSION): validate_protocol_version,
             cv.Required(CONF_SUPPORTED_MODES): cv.ensure_list(validate_climate_mode),
             cv.Required(CONF_SUPPORTED_FAN_MODES): cv.ensure_list(validate_climate_fan_mode),
             cv.Optional(CONF_SUPPORTED_SWING_MODES): cv.ensure_list(validate_climate_swing_mode),
+            cv.Optional(CONF_STATE_HEARTBEAT, default="60s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_PERSIST_STATE, default=False): cv.boolean,
+            cv.Optional(CONF_STATE_SAVE_DELAY, default="60s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_OPTIMISTIC, default=False): cv.boolean,
+            cv.Optional(CONF_OPTIMISTIC_TIMEOUT, default="10s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_TX_PACING, default="FIXED"): cv.enum(TX_PACING_OPTIONS, upper=True),
+            cv.Optional(CONF_COMMAND_TIMEOUT, default="1s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_COMMAND_RETRIES, default=2): cv.int_range(0, 10),
+            cv.Optional(CONF_RX_TASK, default=False): validate_rx_task,
+            cv.Optional(CONF_LOOP_BUDGET, default={}): LOOP_BUDGET_SCHEMA,
+            cv.Optional(CONF_PROFILE_PIPELINE, default=False): cv.boolean,
+            cv.Optional(CONF_SIMULATOR): SIMULATOR_SCHEMA,
+            cv.Optional(CONF_STATE_LOG_MODE, default="CHANGES"): cv.enum(STATE_LOG_MODE_OPTIONS, upper=True),
+            cv.Optional(CONF_STATE_LOG_LEVEL, default="DEBUG"): cv.enum(STATE_LOG_LEVELS, upper=True),
+            cv.Optional(CONF_CAPTURE_BUFFER_SIZE, default=0): cv.int_range(0, 65535),
+            cv.Optional(CONF_FLIGHT_RECORDER_SIZE, default=0): cv.int_range(0, 1024),
+            cv.Optional(CONF_DIAGNOSTICS): DIAGNOSTICS_SCHEMA,
             cv.Optional(CONF_WATER_TANK_STATUS): binary_sensor.binary_sensor_schema(
                 icon=ICON_WATER_TANK_STATUS,
             ),
@@ -43,13 +248,111 @@ CONFIG_SCHEMA = cv.All(
     .extend(uart.UART_DEVICE_SCHEMA),
 )
 
+def validate_capture_data(value):
+    value = cv.string_strict(value)
+    try:
+        return list(bytes.fromhex(value))
+    except ValueError as err:
+        raise cv.Invalid(f"Capture data must be a hex string: {err}")
+
+JHS_AC_ACTION_SCHEMA = automation.maybe_simple_id(
+    {
+        cv.GenerateID(): cv.use_id(JhsAirConditioner),
+    }
+)
+
+CAPTURE_REPLAY_ACTION_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.use_id(JhsAirConditioner),
+        cv.Optional(CONF_DATA): validate_capture_data,
+        cv.Optional(CONF_SPEED, default="ORIGINAL"): cv.enum(REPLAY_SPEED_OPTIONS, upper=True),
+    }
+)
+
+@automation.register_action("jhs_ac.capture_start", CaptureStartAction, JHS_AC_ACTION_SCHEMA)
+@automation.register_action("jhs_ac.capture_stop", CaptureStopAction, JHS_AC_ACTION_SCHEMA)
+@automation.register_action("jhs_ac.capture_dump", CaptureDumpAction, JHS_AC_ACTION_SCHEMA)
+async def capture_action_to_code(config, action_id, template_arg, args):
+    # capture actions need capture support, even if buffer size isn't set
+    cg.add_define("USE_JHS_AC_CAPTURE")
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
+
+@automation.register_action("jhs_ac.flight_recorder_dump", FlightRecorderDumpAction, JHS_AC_ACTION_SCHEMA)
+async def flight_recorder_action_to_code(config, action_id, template_arg, args):
+    cg.add_define("USE_JHS_AC_FLIGHT_RECORDER")
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
+
+@automation.register_action("jhs_ac.latency_reset", LatencyResetAction, JHS_AC_ACTION_SCHEMA)
+async def simple_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
+
+@automation.register_action("jhs_ac.capture_replay", CaptureReplayAction, CAPTURE_REPLAY_ACTION_SCHEMA)
+async def capture_replay_action_to_code(config, action_id, template_arg, args):
+    cg.add_define("USE_JHS_AC_CAPTURE")
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    if CONF_DATA in config:
+        cg.add(var.set_data(config[CONF_DATA]))
+    cg.add(var.set_speed(config[CONF_SPEED]))
+    return var
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await climate.register_climate(var, config)
     await uart.register_uart_device(var, config)
 
-    cg.add_define("JHS_AC_PROTOCOL_VERSION", config[CONF_PROTOCOL_VERSION])
+    cg.add(var.set_protocol_version(config[CONF_PROTOCOL_VERSION]))
+    cg.add(var.set_state_heartbeat_interval(config[CONF_STATE_HEARTBEAT]))
+    cg.add(var.set_persist_state(config[CONF_PERSIST_STATE]))
+    cg.add(var.set_state_save_delay(config[CONF_STATE_SAVE_DELAY]))
+    cg.add(var.set_optimistic(config[CONF_OPTIMISTIC]))
+    cg.add(var.set_optimistic_timeout(config[CONF_OPTIMISTIC_TIMEOUT]))
+    cg.add(var.set_tx_pacing(config[CONF_TX_PACING]))
+    cg.add(var.set_command_timeout(config[CONF_COMMAND_TIMEOUT]))
+    cg.add(var.set_command_max_retries(config[CONF_COMMAND_RETRIES]))
+    if config[CONF_RX_TASK]:
+        # define only compiles reader task support in, every entity decides whether to start it
+        cg.add_define("USE_JHS_AC_RX_TASK")
+        cg.add(var.set_rx_task(True))
+
+    budget = config[CONF_LOOP_BUDGET]
+    cg.add(var.set_loop_budget(budget[CONF_MAX_BYTES], budget[CONF_MAX_FRAMES], budget[CONF_MAX_TIME]))
+    cg.add(var.set_state_log_mode(config[CONF_STATE_LOG_MODE]))
+    cg.add(var.set_state_log_level(config[CONF_STATE_LOG_LEVEL]))
+    if config[CONF_CAPTURE_BUFFER_SIZE] > 0:
+        # recorder, replayer and their calls on every UART access are compiled in only when used
+        cg.add_define("USE_JHS_AC_CAPTURE")
+        cg.add(var.set_capture_buffer_size(config[CONF_CAPTURE_BUFFER_SIZE]))
+    if config[CONF_FLIGHT_RECORDER_SIZE] > 0:
+        cg.add_define("USE_JHS_AC_FLIGHT_RECORDER")
+        cg.add(var.set_flight_recorder_size(config[CONF_FLIGHT_RECORDER_SIZE]))
+
+    if config[CONF_PROFILE_PIPELINE]:
+        # same as with reader task, define only compiles profiler in and other entities aren't measured
+        cg.add_define("USE_JHS_AC_PROFILING")
+        cg.add(var.set_profile_pipeline(True))
+
+    if CONF_SIMULATOR in config:
+        # production firmware doesn't carry simulator or checks for it on every UART access
+        cg.add_define("USE_JHS_AC_SIMULATOR")
+        conf = config[CONF_SIMULATOR]
+        sim = cg.new_Pvariable(conf[CONF_ID])
+        # simulated unit needs definite version, when component detects it automatically
+        default_version = config[CONF_PROTOCOL_VERSION] or 1
+        cg.add(sim.set_protocol_version(conf.get(CONF_PROTOCOL_VERSION, default_version)))
+        cg.add(sim.set_reaction_delay(conf[CONF_REACTION_DELAY]))
+        cg.add(sim.set_report_interval(conf[CONF_REPORT_INTERVAL]))
+        cg.add(sim.set_drop_probability(conf[CONF_DROP_PROBABILITY]))
+        cg.add(sim.set_bit_flip_probability(conf[CONF_BIT_FLIP_PROBABILITY]))
+        cg.add(sim.set_partial_frame_probability(conf[CONF_PARTIAL_FRAME_PROBABILITY]))
+        cg.add(var.set_simulator(sim))
     
     if CONF_SUPPORTED_MODES in config:
         for mode in config[CONF_SUPPORTED_MODES]:
@@ -63,6 +366,19 @@ async def to_code(config):
         for swing_mode in config[CONF_SUPPORTED_SWING_MODES]:
             cg.add(var.add_supported_swing_mode(swing_mode))
     
+    if CONF_DIAGNOSTICS in config:
+        conf = config[CONF_DIAGNOSTICS]
+        cg.add(var.set_diagnostics_update_interval(conf[CONF_UPDATE_INTERVAL]))
+        for key, (counter, _) in COUNTER_SENSORS.items():
+            if key in conf:
+                sens = await sensor.new_sensor(conf[key])
+                cg.add(var.set_counter_sensor(counter, sens))
+        for key, metric in LATENCY_METRICS.items():
+            for statistic_key, statistic in LATENCY_STATISTICS.items():
+                if statistic_key in conf.get(key, {}):
+                    sens = await sensor.new_sensor(conf[key][statistic_key])
+                    cg.add(var.set_latency_sensor(metric, statistic, sens))
+
     if CONF_WATER_TANK_STATUS in config:
         conf = config[CONF_WATER_TANK_STATUS]
         sens = await binary_sensor.new_binary_sensor(conf)
@@ -0,0 +1,110 @@
+#include "command_frames.h"
+#include <cstring>
+#ifdef USE_ESP8266
+#include <pgmspace.h>
+#endif
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+namespace esphome::jhs_ac {
+
+namespace {
+
+struct FrameTable
+{
+    CommandFrame frames[CommandFrames::FRAMES_COUNT];
+};
+
+struct FrameOffsets
+{
+    uint8_t offsets[CommandFrames::FUNCTIONS_COUNT];
+};
+
+constexpr FrameTable build_frame_table()
+{
+    FrameTable table = {};
+    uint32_t index = 0;
+    for (uint32_t version = 1; version <= CommandFrames::PROTOCOL_VERSIONS_COUNT; version++)
+    {
+        for (const CommandArgumentRange &range : COMMAND_ARGUMENT_RANGES)
+        {
+            for (uint32_t argument = range.min; argument <= range.max; argument++) {
+                table.frames[index++] = CommandFrames::make_frame(version, range.function, argument);
+            }
+        }
+    }
+    return table;
+}
+
+constexpr FrameOffsets build_frame_offsets()
+{
+    FrameOffsets offsets = {};
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < CommandFrames::FUNCTIONS_COUNT; i++)
+    {
+        offsets.offsets[i] = index;
+        index += COMMAND_ARGUMENT_RANGES[i].max - COMMAND_ARGUMENT_RANGES[i].min + 1;
+    }
+    return offsets;
+}
+
+constexpr bool validate_frame_table(const FrameTable &table)
+{
+    for (const CommandFrame &frame : table.frames)
+    {
+        const uint32_t sum = frame.data[1] + frame.data[2] + frame.data[3];
+        if (frame.data[0] != AirConditionerCommand::PACKET_START_MARKER ||
+            frame.data[4] != sum % 256 ||
+            frame.data[AirConditionerCommand::PACKET_AC_COMMAND_SIZE - 1] != AirConditionerCommand::PACKET_END_MARKER) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(validate_frame_table(build_frame_table()), "Command frame table contains invalid frames.");
+static_assert(sizeof(FrameTable) == CommandFrames::FRAMES_COUNT * AirConditionerCommand::PACKET_AC_COMMAND_SIZE, 
+    "Command frames should be packed without padding.");
+
+// on ESP8266 constant data is copied to RAM at boot unless it's placed in flash explicitly,
+// so frames are kept there and read only through memcpy_P(), small offsets table stays in RAM
+const FrameTable FRAME_TABLE PROGMEM = build_frame_table();
+constexpr FrameOffsets FRAME_OFFSETS = build_frame_offsets();
+
+void copy_frame(CommandFrame &destination, const CommandFrame &source)
+{
+#ifdef USE_ESP8266
+    memcpy_P(&destination, &source, sizeof(CommandFrame));
+#else
+    std::memcpy(&destination, &source, sizeof(CommandFrame));
+#endif
+}
+
+} // namespace
+
+bool CommandFrames::is_valid(const AirConditionerCommand &command)
+{
+    const uint32_t function_index = get_function_index(command.function);
+    if (function_index >= FUNCTIONS_COUNT) {
+        return false;
+    }
+
+    const CommandArgumentRange &range = COMMAND_ARGUMENT_RANGES[function_index];
+    return command.argument >= range.min && command.argument <= range.max;
+}
+
+bool CommandFrames::find(uint32_t protocol_version, const AirConditionerCommand &command, CommandFrame &frame)
+{
+    if (protocol_version < 1 || protocol_version > PROTOCOL_VERSIONS_COUNT || !is_valid(command)) {
+        return false;
+    }
+
+    const uint32_t function_index = get_function_index(command.function);
+    const uint32_t index = (protocol_version - 1) * FRAMES_PER_VERSION + FRAME_OFFSETS.offsets[function_index] +
+        (command.argument - COMMAND_ARGUMENT_RANGES[function_index].min);
+    copy_frame(frame, FRAME_TABLE.frames[index]);
+    return true;
+}
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,82 @@
+#pragma once
+#include "ac_command.h"
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+struct CommandFrame
+{
+    uint8_t data[AirConditionerCommand::PACKET_AC_COMMAND_SIZE];
+};
+
+static_assert(sizeof(CommandFrame) == AirConditionerCommand::PACKET_AC_COMMAND_SIZE, "Command frame should have exact AC command packet size.");
+
+struct CommandArgumentRange
+{
+    AirConditionerCommand::Function function;
+    uint8_t min;
+    uint8_t max;
+};
+
+// valid arguments of every AC function, ordered by function code
+inline constexpr CommandArgumentRange COMMAND_ARGUMENT_RANGES[] = {
+    {AirConditionerCommand::Function::Power, 0, 1},
+    {AirConditionerCommand::Function::Mode, 1, 4},
+    {AirConditionerCommand::Function::Sleep, 0, 1},
+    {AirConditionerCommand::Function::Temperature, 16, 31},
+    {AirConditionerCommand::Function::Oscillation, 0, 1},
+    {AirConditionerCommand::Function::FanSpeed, 1, 3},
+};
+
+constexpr uint32_t get_command_arguments_count()
+{
+    uint32_t count = 0;
+    for (const CommandArgumentRange &range : COMMAND_ARGUMENT_RANGES) {
+        count += range.max - range.min + 1;
+    }
+    return count;
+}
+
+// Every valid command frame for both protocol versions is generated at compile time,
+// so sending command does not involve any serialization work.
+class CommandFrames
+{
+public:
+    static constexpr uint32_t PROTOCOL_VERSIONS_COUNT = 2;
+    static constexpr uint32_t FUNCTIONS_COUNT = sizeof(COMMAND_ARGUMENT_RANGES) / sizeof(COMMAND_ARGUMENT_RANGES[0]);
+    static constexpr uint32_t FRAMES_PER_VERSION = get_command_arguments_count();
+    static constexpr uint32_t FRAMES_COUNT = FRAMES_PER_VERSION * PROTOCOL_VERSIONS_COUNT;
+
+    static constexpr CommandFrame make_frame(uint32_t protocol_version, AirConditionerCommand::Function function, uint8_t argument)
+    {
+        const uint8_t function_code = static_cast<uint8_t>(function);
+        const uint8_t version_byte = protocol_version == 1 ? argument : 0x01;
+        const uint8_t checksum = static_cast<uint8_t>((function_code + version_byte + argument) % 256);
+        return CommandFrame{{
+            AirConditionerCommand::PACKET_START_MARKER,
+            function_code,
+            version_byte,
+            argument,
+            checksum,
+            AirConditionerCommand::PACKET_END_MARKER
+        }};
+    }
+
+    static constexpr const CommandArgumentRange &get_argument_range(AirConditionerCommand::Function function)
+    {
+        return COMMAND_ARGUMENT_RANGES[get_function_index(function)];
+    }
+
+    // checks whether command argument is within valid range, regardless of protocol version
+    static bool is_valid(const AirConditionerCommand &command);
+    // copies frame of given command, returns false for unknown protocol version or argument out of valid range
+    static bool find(uint32_t protocol_version, const AirConditionerCommand &command, CommandFrame &frame);
+
+private:
+    static constexpr uint32_t get_function_index(AirConditionerCommand::Function function)
+    {
+        return static_cast<uint8_t>(function) - static_cast<uint8_t>(AirConditionerCommand::Function::Power);
+    }
+};
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,62 @@
+#include "command_scheduler.h"
+
+namespace esphome::jhs_ac {
+
+bool CommandScheduler::schedule(const AirConditionerCommand &command, uint32_t current_time)
+{
+    Slot &slot = m_slots[get_slot_index(command.function)];
+    const bool replaced = slot.pending;
+    if (!replaced) 
+    {
+        // replaced command keeps its position in queue and time when it was first queued
+        slot.sequence = m_sequence++;
+        slot.queued_time = current_time;
+        slot.pending = true;
+    }
+    slot.command = command;
+    return replaced;
+}
+
+std::optional<ScheduledCommand> CommandScheduler::pop()
+{
+    Slot *next_slot = nullptr;
+    bool next_high_priority = false;
+    for (uint32_t i = 0; i < FUNCTIONS_COUNT; i++)
+    {
+        Slot &slot = m_slots[i];
+        if (!slot.pending) {
+            continue;
+        }
+
+        const bool high_priority = is_high_priority(slot.command.function);
+        if (next_slot == nullptr || 
+            (high_priority && !next_high_priority) || 
+            (high_priority == next_high_priority && slot.sequence < next_slot->sequence)) 
+        {
+            next_slot = &slot;
+            next_high_priority = high_priority;
+        }
+    }
+
+    if (next_slot == nullptr) {
+        return std::nullopt;
+    }
+    next_slot->pending = false;
+    return ScheduledCommand{next_slot->command, next_slot->queued_time};
+}
+
+uint32_t CommandScheduler::size() const
+{
+    uint32_t count = 0;
+    for (const Slot &slot : m_slots) {
+        count += slot.pending ? 1 : 0;
+    }
+    return count;
+}
+
+bool CommandScheduler::is_high_priority(AirConditionerCommand::Function function)
+{
+    return function == AirConditionerCommand::Function::Power || function == AirConditionerCommand::Function::Mode;
+}
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,60 @@
+#pragma once
+#include "ac_command.h"
+#include <optional>
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+struct ScheduledCommand
+{
+    AirConditionerCommand command;
+    uint32_t queued_time;
+};
+
+// Holds single pending command per AC function, so newer command replaces queued one 
+// of the same function instead of being appended. Power and mode commands are sent 
+// before the rest, otherwise commands are sent in order they were first queued.
+class CommandScheduler
+{
+public:
+    CommandScheduler() : m_slots{}, m_sequence(0) {}
+
+    bool schedule(const AirConditionerCommand &command, uint32_t current_time);
+    std::optional<ScheduledCommand> pop();
+    bool is_pending(AirConditionerCommand::Function function) const { return m_slots[get_slot_index(function)].pending; }
+    bool is_empty() const { return size() == 0; }
+    uint32_t size() const;
+
+    template<class Callback> void for_each_pending(Callback &&callback) const
+    {
+        for (const Slot &slot : m_slots)
+        {
+            if (slot.pending) {
+                callback(slot.command);
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t FUNCTIONS_COUNT = 6;
+
+    static constexpr uint32_t get_slot_index(AirConditionerCommand::Function function) 
+    {
+        return static_cast<uint8_t>(function) - static_cast<uint8_t>(AirConditionerCommand::Function::Power);
+    }
+
+    struct Slot
+    {
+        AirConditionerCommand command;
+        uint32_t queued_time;
+        uint32_t sequence;
+        bool pending;
+    };
+
+    static bool is_high_priority(AirConditionerCommand::Function function);
+
+    Slot m_slots[FUNCTIONS_COUNT];
+    uint32_t m_sequence;
+};
+
+} // namespace esphome::jhs_ac
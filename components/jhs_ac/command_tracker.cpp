@@ -0,0 +1,54 @@
+#include "command_tracker.h"
+#include <algorithm>
+
+namespace esphome::jhs_ac {
+
+void CommandTracker::track(const AirConditionerCommand &command, uint32_t queued_time, uint32_t current_time)
+{
+    OutstandingCommand &outstanding = m_commands[get_slot_index(command.function)];
+    outstanding.command = command;
+    outstanding.queued_time = queued_time;
+    outstanding.first_send_time = current_time;
+    outstanding.last_send_time = current_time;
+    outstanding.retries = 0;
+    outstanding.outstanding = true;
+}
+
+void CommandTracker::cancel(AirConditionerCommand::Function function)
+{
+    m_commands[get_slot_index(function)].outstanding = false;
+}
+
+void CommandTracker::give_up(OutstandingCommand &command)
+{
+    command.outstanding = false;
+}
+
+CommandTracker::OutstandingCommand *CommandTracker::find_expired(uint32_t current_time, uint32_t timeout)
+{
+    for (OutstandingCommand &command : m_commands)
+    {
+        if (command.outstanding)
+        {
+            // timeout doubles with every retry, up to bounded factor
+            const uint32_t backoff_factor = std::min<uint32_t>(1U << std::min<uint32_t>(command.retries, 31), MAX_BACKOFF_FACTOR);
+            if (current_time - command.last_send_time >= timeout * backoff_factor) {
+                return &command;
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool CommandTracker::is_empty() const
+{
+    for (const OutstandingCommand &command : m_commands)
+    {
+        if (command.outstanding) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace esphome::jhs_ac
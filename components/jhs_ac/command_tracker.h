@@ -0,0 +1,81 @@
+#pragma once
+#include "ac_command.h"
+#include "ac_state.h"
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+struct CommandDelivery
+{
+    AirConditionerCommand::Function function;
+    uint32_t latency;           // since command was sent first time
+    uint32_t request_latency;   // since command was queued
+    uint32_t retries;
+};
+
+// Keeps commands sent to AC until received state shows that they were applied,
+// at most one outstanding command per AC function.
+class CommandTracker
+{
+public:
+    struct OutstandingCommand
+    {
+        AirConditionerCommand command;
+        uint32_t queued_time;
+        uint32_t first_send_time;
+        uint32_t last_send_time;
+        uint32_t retries;
+        bool outstanding;
+    };
+
+    CommandTracker() : m_commands{} {}
+
+    void track(const AirConditionerCommand &command, uint32_t queued_time, uint32_t current_time);
+    void cancel(AirConditionerCommand::Function function);
+    void give_up(OutstandingCommand &command);
+    OutstandingCommand *find_expired(uint32_t current_time, uint32_t timeout);
+    bool is_empty() const;
+    bool is_outstanding(AirConditionerCommand::Function function) const { return m_commands[get_slot_index(function)].outstanding; }
+
+    template<class Callback> void for_each_outstanding(Callback &&callback) const
+    {
+        for (const OutstandingCommand &outstanding : m_commands)
+        {
+            if (outstanding.outstanding) {
+                callback(outstanding.command);
+            }
+        }
+    }
+
+    // callback is invoked for every outstanding command applied in given state
+    template<class Callback> void confirm(const AirConditionerState &state, uint32_t current_time, Callback &&on_confirmed)
+    {
+        for (OutstandingCommand &outstanding : m_commands)
+        {
+            if (outstanding.outstanding && outstanding.command.is_applied(state))
+            {
+                outstanding.outstanding = false;
+                const CommandDelivery delivery = {
+                    outstanding.command.function, 
+                    current_time - outstanding.first_send_time, 
+                    current_time - outstanding.queued_time,
+                    outstanding.retries
+                };
+                on_confirmed(delivery);
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t FUNCTIONS_COUNT = 6;
+    static constexpr uint32_t MAX_BACKOFF_FACTOR = 8;
+
+    static constexpr uint32_t get_slot_index(AirConditionerCommand::Function function) 
+    {
+        return static_cast<uint8_t>(function) - static_cast<uint8_t>(AirConditionerCommand::Function::Power);
+    }
+
+    OutstandingCommand m_commands[FUNCTIONS_COUNT];
+};
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+// Cheap counters of receive and transmit path, which help to spot degraded UART link 
+// or stalled loop without attaching to device logs
+class DiagnosticCounters
+{
+public:
+    enum class Counter : uint8_t
+    {
+        BytesReceived,
+        FramesParsed,
+        ChecksumErrors,
+        Resyncs,
+        DiscardedBytes,
+        RxBufferHighWater,
+        RxBufferOverflows,
+        TxQueueHighWater,
+        TxQueueDrops,
+        CommandRetries,
+        MaxLoopDuration,
+        OptimisticRollbacks,
+        Count
+    };
+
+    DiagnosticCounters() : m_values{} {}
+
+    void add(Counter counter, uint32_t value = 1) { m_values[static_cast<uint8_t>(counter)] += value; }
+    void set(Counter counter, uint32_t value) { m_values[static_cast<uint8_t>(counter)] = value; }
+    uint32_t get(Counter counter) const { return m_values[static_cast<uint8_t>(counter)]; }
+
+    void update_max(Counter counter, uint32_t value)
+    {
+        uint32_t &current = m_values[static_cast<uint8_t>(counter)];
+        current = (value > current) ? value : current;
+    }
+
+private:
+    uint32_t m_values[static_cast<uint8_t>(Counter::Count)];
+};
+
+} // namespace esphome::jhs_ac
@@ -1,6 +1,7 @@
 #pragma once
-#include "esphome/core/optional.h"
+#include <optional>
 #include <stdint.h>
+#include <algorithm>
 
 namespace esphome::jhs_ac {
 
@@ -18,6 +19,7 @@ public:
     T& front() { return m_buffer[0]; }
     T& back() { return m_buffer[(m_size == 0) ? 0 : m_size - 1]; }
     T& operator[](const uint32_t index) { return m_buffer[index]; }
+    const T* data() const { return m_buffer; }
 
     bool push_back(const T& value) 
     {
@@ -31,7 +33,18 @@ public:
         return false;
     }
 
-    optional<T> pop_back() 
+    bool append(const T *values, uint32_t count)
+    {
+        if (count <= N - m_size)
+        {
+            std::copy(values, values + count, m_buffer + m_size);
+            m_size += count;
+            return true;
+        }
+        return false;
+    }
+
+    std::optional<T> pop_back() 
     {
         T result = m_buffer[m_size];
         if (m_size > 0) 
@@ -39,7 +52,7 @@ public:
             m_size--;
             return result;
         }
-        return nullopt;
+        return std::nullopt;
     }
 
 private:
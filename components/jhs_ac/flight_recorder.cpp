@@ -0,0 +1,36 @@
+#include "flight_recorder.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome::jhs_ac {
+
+void FlightRecorder::allocate(uint32_t capacity)
+{
+    m_records.reset(capacity > 0 ? new Record[capacity] : nullptr);
+    m_capacity = capacity;
+    clear();
+}
+
+void FlightRecorder::record(RecordType type, const uint8_t *data, uint32_t length, uint32_t current_time)
+{
+    if (m_capacity == 0) {
+        return;
+    }
+
+    Record &record = m_records[m_head];
+    record.timestamp = current_time;
+    record.type = type;
+    record.length = std::min(length, MAX_FRAME_SIZE);
+    std::memcpy(record.data, data, record.length);
+
+    m_head = m_head + 1 == m_capacity ? 0 : m_head + 1;
+    m_count = std::min(m_count + 1, m_capacity);
+}
+
+void FlightRecorder::clear()
+{
+    m_head = 0;
+    m_count = 0;
+}
+
+} // namespace esphome::jhs_ac
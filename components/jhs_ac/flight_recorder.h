@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <memory>
+
+namespace esphome::jhs_ac {
+
+// Keeps last frames sent or received over UART in their binary form,
+// formatting is left to the moment when records are actually dumped
+class FlightRecorder
+{
+public:
+    static constexpr uint32_t MAX_FRAME_SIZE = 18;
+
+    enum class RecordType : uint8_t
+    {
+        Sent,
+        Received,
+        Rejected    // received frame which failed end marker or checksum check
+    };
+
+    struct Record
+    {
+        uint32_t timestamp;
+        RecordType type;
+        uint8_t length;
+        uint8_t data[MAX_FRAME_SIZE];
+    };
+
+    FlightRecorder() : m_capacity(0), m_head(0), m_count(0) {}
+
+    void allocate(uint32_t capacity);
+    void record(RecordType type, const uint8_t *data, uint32_t length, uint32_t current_time);
+    void clear();
+
+    uint32_t get_capacity() const { return m_capacity; }
+    uint32_t get_count() const { return m_count; }
+
+    // records are passed to callback from oldest to newest
+    template<class Callback> void for_each(Callback &&callback) const
+    {
+        uint32_t index = m_count < m_capacity ? 0 : m_head;
+        for (uint32_t i = 0; i < m_count; i++)
+        {
+            callback(m_records[index]);
+            index = index + 1 == m_capacity ? 0 : index + 1;
+        }
+    }
+
+private:
+    std::unique_ptr<Record[]> m_records;
+    uint32_t m_capacity;
+    uint32_t m_head;
+    uint32_t m_count;
+};
+
+} // namespace esphome::jhs_ac
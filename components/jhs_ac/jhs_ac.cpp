@@ -1,26 +1,54 @@
 #include "jhs_ac.h"
-#include "binary_input_stream.h"
-#include "power_command.h"
-#include "mode_command.h"
-#include "fan_speed_command.h"
-#include "sleep_command.h"
-#include "temperature_command.h"
-#include "oscillation_command.h"
+#include "ac_state_view.h"
+#include "command_frames.h"
 #include "esphome/core/version.h"
 #include "esphome/core/macros.h"
 #include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
+#ifdef USE_JHS_AC_RX_TASK
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
 #include <cmath>
 #include <cstring>
 #include <algorithm>
 
-#define VERBOSE_LOGGING 1
-
 #if ESPHOME_VERSION_CODE < VERSION_CODE(2025, 11, 0)
 static_assert(false, "Minimal supported ESPHome version is 2025.11.0");
 #endif
 
 namespace esphome::jhs_ac {
 
+#ifdef USE_JHS_AC_PROFILING
+class ProfilingScope
+{
+public:
+    // disabled scope doesn't read cycle counter, so instances without profiling pay only for the check
+    ProfilingScope(PipelineProfiler &profiler, PipelineProfiler::Stage stage, bool enabled) : 
+        m_profiler(enabled ? &profiler : nullptr),
+        m_stage(stage),
+        m_mark(enabled ? profiler.begin(arch_get_cpu_cycle_count()) : PipelineProfiler::StageMark{}) {}
+
+    ~ProfilingScope()
+    {
+        if (m_profiler) {
+            m_profiler->end(m_stage, m_mark, arch_get_cpu_cycle_count());
+        }
+    }
+
+private:
+    PipelineProfiler *m_profiler;
+    PipelineProfiler::Stage m_stage;
+    PipelineProfiler::StageMark m_mark;
+};
+
+#define PROFILE_STAGE(stage) ProfilingScope profiling_scope(m_profiler, PipelineProfiler::Stage::stage, m_profile_pipeline)
+#else
+#define PROFILE_STAGE(stage)
+#endif
+
 void JhsAirConditioner::setup()
 {
     flush();
@@ -41,26 +69,160 @@ void JhsAirConditioner::setup()
     // hardcoded for now, but may become optional in future
     m_traits.set_supported_presets({climate::CLIMATE_PRESET_NONE, 
                                     climate::CLIMATE_PRESET_SLEEP});
+
+    if (m_protocol_version == PROTOCOL_VERSION_AUTO) {
+        restore_protocol_version();
+    }
+
+    if (m_persist_state) {
+        restore_persisted_state();
+    }
+
+#ifdef USE_JHS_AC_CAPTURE
+    m_capture.allocate(m_capture_buffer_size);
+#endif
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+    m_flight_recorder.allocate(m_flight_recorder_size);
+#endif
+
+    // interval is set only when diagnostics section is configured
+    if (m_diagnostics_update_interval > 0) {
+        set_interval("diagnostics", m_diagnostics_update_interval, [this]() { publish_diagnostics(); });
+    }
+
+#ifdef USE_JHS_AC_RX_TASK
+    if (m_rx_task_enabled && !is_simulated()) 
+    {
+        m_rx_task_started = xTaskCreate(rx_task, "jhs_ac_rx", RX_TASK_STACK_SIZE, this, RX_TASK_PRIORITY, nullptr) == pdPASS;
+        if (!m_rx_task_started) {
+            ESP_LOGE(TAG, "Failed to start UART reader task, UART is read from loop instead");
+        }
+    }
+#endif
+
+#ifdef USE_JHS_AC_PROFILING
+    if (m_profile_pipeline)
+    {
+        set_interval("profiling_report", PROFILING_REPORT_INTERVAL_MS, [this]() {
+            dump_profiling_report();
+            m_profiler.reset();
+        });
+    }
+#endif
 }
 
 void JhsAirConditioner::loop()
 {
+    const uint32_t loop_start_time = micros();
     read_uart_data();
     parse_received_data();
+#ifdef USE_JHS_AC_CAPTURE
+    if (m_replayer.is_active()) {
+        replay_capture();
+    }
+#endif
     send_queued_command();
+    if (m_optimistic_active) {
+        update_optimistic_state(App.get_loop_component_start_time());
+    }
+    m_counters.update_max(DiagnosticCounters::Counter::MaxLoopDuration, micros() - loop_start_time);
+
+    // only reader task can wake up loop when data arrives, otherwise ESPHome gives no notification 
+    // about received UART data and loop has to poll it, which is cheaper than any timer-based polling
+    if (is_rx_task_started() && is_idle()) {
+        disable_loop();
+    }
+}
+
+bool JhsAirConditioner::is_idle() const
+{
+#ifdef USE_JHS_AC_RX_TASK
+    if (!m_rx_ring.is_empty()) {
+        return false;
+    }
+#endif
+#ifdef USE_JHS_AC_CAPTURE
+    // simulator and replay produce data only when polled from loop
+    if (m_replayer.is_active()) {
+        return false;
+    }
+#endif
+    return m_data_buffer.is_empty() && m_tx_queue.is_empty() && m_command_tracker.is_empty() &&
+        !is_simulated() && !m_protocol_probe.is_active() && !m_optimistic_active;
+}
+
+bool JhsAirConditioner::is_rx_task_started() const
+{
+#ifdef USE_JHS_AC_RX_TASK
+    return m_rx_task_started;
+#else
+    return false;
+#endif
+}
+
+bool JhsAirConditioner::is_simulated() const
+{
+#ifdef USE_JHS_AC_SIMULATOR
+    return m_simulator != nullptr;
+#else
+    return false;
+#endif
 }
 
 void JhsAirConditioner::dump_config()
 {
     ESP_LOGCONFIG(TAG, "JHS Air Conditioner Component:");
-    ESP_LOGCONFIG(TAG, "Protocol version: %d", JHS_AC_PROTOCOL_VERSION);
+    if (m_protocol_version != PROTOCOL_VERSION_AUTO) {
+        ESP_LOGCONFIG(TAG, "Protocol version: %u", m_protocol_version);
+    }
+    else {
+        ESP_LOGCONFIG(TAG, "Protocol version: detecting");
+    }
+    ESP_LOGCONFIG(TAG, "State heartbeat interval: %u ms", m_state_heartbeat_interval);
+    if (m_optimistic) {
+        ESP_LOGCONFIG(TAG, "Optimistic mode with %u ms timeout", m_optimistic_timeout);
+    }
+    if (m_persist_state) {
+        ESP_LOGCONFIG(TAG, "State is persisted after %u ms of stability", m_state_persistence.get_save_delay());
+    }
+    ESP_LOGCONFIG(TAG, "TX pacing: %s", m_tx_pacing == TxPacing::Adaptive ? "Adaptive" : "Fixed");
+    ESP_LOGCONFIG(TAG, "Command timeout: %u ms", m_command_timeout);
+    ESP_LOGCONFIG(TAG, "Command retries: %u", m_command_max_retries);
+    // one-off figure of object size and buffers allocated in setup, it doesn't include heap of 
+    // climate traits and scheduler, see instances_benchmark host test for measured cost
+    uint32_t buffers_size = 0;
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+    buffers_size += m_flight_recorder.get_capacity() * static_cast<uint32_t>(sizeof(FlightRecorder::Record));
+#endif
+#ifdef USE_JHS_AC_CAPTURE
+    buffers_size += m_capture.get_capacity();
+#endif
+    ESP_LOGCONFIG(TAG, "Instance size: %u bytes, buffers: %u bytes", static_cast<uint32_t>(sizeof(*this)), buffers_size);
+    ESP_LOGCONFIG(TAG, "UART reader task: %s", is_rx_task_started() ? "Yes" : "No");
+    ESP_LOGCONFIG(TAG, "Loop budget: %u bytes, %u frames, %u us (0 is unlimited)", 
+        m_loop_max_bytes, m_loop_max_frames, m_loop_max_time);
+#ifdef USE_JHS_AC_SIMULATOR
+    if (m_simulator)
+    {
+        ESP_LOGCONFIG(TAG, "Simulated AC unit is used instead of UART:");
+        ESP_LOGCONFIG(TAG, "  Protocol version: %u", m_simulator->get_protocol_version());
+        ESP_LOGCONFIG(TAG, "  Reaction delay: %u ms", m_simulator->get_reaction_delay());
+        ESP_LOGCONFIG(TAG, "  Report interval: %u ms", m_simulator->get_report_interval());
+    }
+#endif
+    ESP_LOGCONFIG(TAG, "State logging: %s", m_state_log_mode == StateLogMode::Full ? "Full" : "Changes");
+#ifdef USE_JHS_AC_CAPTURE
+    ESP_LOGCONFIG(TAG, "Capture buffer size: %u bytes", m_capture_buffer_size);
+#endif
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+    ESP_LOGCONFIG(TAG, "Flight recorder size: %u frames", m_flight_recorder_size);
+#endif
     this->dump_traits_(TAG);
     this->check_uart_settings(9600, 1, uart::UART_CONFIG_PARITY_NONE, 8);
 }
 
 void JhsAirConditioner::control(const climate::ClimateCall &call)
 {
-    uint8_t packet_data[64];
     auto mode = call.get_mode();
     auto fan_mode = call.get_fan_mode();
     auto preset = call.get_preset();
@@ -69,32 +231,24 @@ void JhsAirConditioner::control(const climate::ClimateCall &call)
     
     if (mode.has_value())
     {
-        bool waking_up_ac = !m_state.power && mode.value() != climate::CLIMATE_MODE_OFF;
+        // AC may still report power state which unconfirmed command is about to change
+        bool waking_up_ac = mode.value() != climate::CLIMATE_MODE_OFF && 
+            is_command_required(!m_state.power, AirConditionerCommand::Function::Power);
         bool turning_off_ac = mode.value() == climate::CLIMATE_MODE_OFF;
 
         // turn on AC before changing mode to something else
-        if (waking_up_ac || turning_off_ac)
-        {
-            PowerCommand power_command;
-            BinaryOutputStream packet_stream(packet_data, sizeof(packet_data));
-            power_command.toggle(waking_up_ac ? true : false);
-            power_command.write_to_packet(packet_stream);
-            add_packet_to_queue(packet_stream);  
+        if (waking_up_ac || turning_off_ac) {
+            add_command_to_queue(AirConditionerCommand::power(waking_up_ac));
         }
 
         if (mode.value() != climate::CLIMATE_MODE_OFF)
         {
-            ModeCommand mode_command;
-            BinaryOutputStream packet_stream(packet_data, sizeof(packet_data));
             auto desired_mode = get_mapped_ac_mode(mode.value());
 
             if (desired_mode.has_value() && m_supported_modes.count(mode.value())) 
             {
-                if (m_state.mode != desired_mode.value())
-                {
-                    mode_command.select(desired_mode.value());
-                    mode_command.write_to_packet(packet_stream);
-                    add_packet_to_queue(packet_stream);
+                if (is_command_required(m_state.mode != desired_mode.value(), AirConditionerCommand::Function::Mode)) {
+                    add_command_to_queue(AirConditionerCommand::mode(desired_mode.value()));
                 }
             }
             else {
@@ -105,17 +259,12 @@ void JhsAirConditioner::control(const climate::ClimateCall &call)
 
     if (fan_mode.has_value())
     {
-        FanSpeedCommand fan_speed_command;
-        BinaryOutputStream packet_stream(packet_data, sizeof(packet_data));
         auto desired_fan_speed = get_mapped_fan_speed(fan_mode.value());
 
         if (desired_fan_speed.has_value() && m_supported_fan_modes.count(fan_mode.value()))
         {
-            if (m_state.fan_speed != desired_fan_speed.value())
-            {
-                fan_speed_command.set_speed(desired_fan_speed.value());
-                fan_speed_command.write_to_packet(packet_stream);
-                add_packet_to_queue(packet_stream);
+            if (is_command_required(m_state.fan_speed != desired_fan_speed.value(), AirConditionerCommand::Function::FanSpeed)) {
+                add_command_to_queue(AirConditionerCommand::fan_speed(desired_fan_speed.value()));
             }
         }
         else {
@@ -125,17 +274,11 @@ void JhsAirConditioner::control(const climate::ClimateCall &call)
 
     if (preset.has_value())
     {
-        SleepCommand sleep_command;
-        BinaryOutputStream packet_stream(packet_data, sizeof(packet_data));
-
         if (preset.value() == climate::CLIMATE_PRESET_SLEEP || preset.value() == climate::CLIMATE_PRESET_NONE)
         {
             const bool desired_sleep_mode = preset.value() == climate::CLIMATE_PRESET_SLEEP;
-            if (m_state.sleep != desired_sleep_mode)
-            {
-                sleep_command.toggle(desired_sleep_mode);
-                sleep_command.write_to_packet(packet_stream);
-                add_packet_to_queue(packet_stream);
+            if (is_command_required(m_state.sleep != desired_sleep_mode, AirConditionerCommand::Function::Sleep)) {
+                add_command_to_queue(AirConditionerCommand::sleep(desired_sleep_mode));
             }
         }
         else {
@@ -145,36 +288,34 @@ void JhsAirConditioner::control(const climate::ClimateCall &call)
 
     if (temperature.has_value())
     {
-        TemperatureCommand temperature_command;
-        BinaryOutputStream packet_stream(packet_data, sizeof(packet_data));
-
-        if (m_state.temperature_setting != temperature.value())
-        {
-            temperature_command.set_temperature(static_cast<int32_t>(temperature.value()));
-            temperature_command.write_to_packet(packet_stream);
-            add_packet_to_queue(packet_stream);
+        if (is_command_required(m_state.temperature_setting != temperature.value(), AirConditionerCommand::Function::Temperature)) {
+            add_command_to_queue(AirConditionerCommand::temperature(static_cast<int32_t>(temperature.value())));
         }
     }
 
     if (swing_mode.has_value())
     {
-        OscillationCommand oscillation_command;
-        BinaryOutputStream packet_stream(packet_data, sizeof(packet_data));
         const bool desired_swing_mode = swing_mode.value() == climate::CLIMATE_SWING_VERTICAL;
 
         if (m_supported_swing_modes.count(swing_mode.value())) 
         {
-            if (m_state.oscillation != desired_swing_mode)
-            {
-                oscillation_command.set_status(desired_swing_mode);
-                oscillation_command.write_to_packet(packet_stream);
-                add_packet_to_queue(packet_stream);
+            if (is_command_required(m_state.oscillation != desired_swing_mode, AirConditionerCommand::Function::Oscillation)) {
+                add_command_to_queue(AirConditionerCommand::oscillation(desired_swing_mode));
             }
         }
         else {
             ESP_LOGW(TAG, "Unsupported swing mode was requested, ignoring");
         }
     }
+
+    // without any report from AC there is no state to base prediction on
+    if (m_optimistic && m_frame_received)
+    {
+        m_optimistic_active = true;
+        m_optimistic_deadline = App.get_loop_component_start_time() + m_optimistic_timeout;
+        update_ac_state(get_predicted_state());
+        enable_loop();
+    }
 }
 
 float JhsAirConditioner::get_setup_priority() const
@@ -182,11 +323,187 @@ float JhsAirConditioner::get_setup_priority() const
     return setup_priority::AFTER_WIFI;
 }
 
+void JhsAirConditioner::set_protocol_version(uint32_t version)
+{
+    m_protocol_version = version;
+}
+
+void JhsAirConditioner::set_rx_task(bool enabled)
+{
+    m_rx_task_enabled = enabled;
+}
+
+void JhsAirConditioner::set_profile_pipeline(bool enabled)
+{
+    m_profile_pipeline = enabled;
+}
+
 void JhsAirConditioner::set_water_tank_sensor(binary_sensor::BinarySensor *sensor)
 {
     m_water_tank_sensor = sensor;
 }
 
+void JhsAirConditioner::set_counter_sensor(DiagnosticCounters::Counter counter, sensor::Sensor *sensor)
+{
+    m_counter_sensors[static_cast<uint8_t>(counter)] = sensor;
+}
+
+void JhsAirConditioner::set_diagnostics_update_interval(uint32_t interval_ms)
+{
+    m_diagnostics_update_interval = interval_ms;
+}
+
+void JhsAirConditioner::set_latency_sensor(LatencyMetric metric, LatencyHistogram::Statistic statistic, sensor::Sensor *sensor)
+{
+    m_latency_sensors[static_cast<uint8_t>(metric)][static_cast<uint8_t>(statistic)] = sensor;
+}
+
+void JhsAirConditioner::reset_latency_histograms()
+{
+    for (LatencyHistogram &histogram : m_latency_histograms) {
+        histogram.reset();
+    }
+    ESP_LOGI(TAG, "Latency histograms were reset");
+}
+
+#ifdef USE_JHS_AC_SIMULATOR
+void JhsAirConditioner::set_simulator(AirConditionerSimulator *simulator)
+{
+    m_simulator = simulator;
+}
+#endif
+
+void JhsAirConditioner::set_state_heartbeat_interval(uint32_t interval_ms)
+{
+    m_state_heartbeat_interval = interval_ms;
+}
+
+void JhsAirConditioner::set_persist_state(bool persist)
+{
+    m_persist_state = persist;
+}
+
+void JhsAirConditioner::set_state_save_delay(uint32_t delay_ms)
+{
+    m_state_persistence.set_save_delay(delay_ms);
+}
+
+void JhsAirConditioner::set_optimistic(bool optimistic)
+{
+    m_optimistic = optimistic;
+}
+
+void JhsAirConditioner::set_optimistic_timeout(uint32_t timeout_ms)
+{
+    m_optimistic_timeout = timeout_ms;
+}
+
+void JhsAirConditioner::set_tx_pacing(TxPacing pacing)
+{
+    m_tx_pacing = pacing;
+}
+
+void JhsAirConditioner::set_command_timeout(uint32_t timeout_ms)
+{
+    m_command_timeout = timeout_ms;
+}
+
+void JhsAirConditioner::set_command_max_retries(uint32_t retries)
+{
+    m_command_max_retries = retries;
+}
+
+void JhsAirConditioner::set_loop_budget(uint32_t max_bytes, uint32_t max_frames, uint32_t max_time_us)
+{
+    m_loop_max_bytes = max_bytes;
+    m_loop_max_frames = max_frames;
+    m_loop_max_time = max_time_us;
+}
+
+void JhsAirConditioner::set_state_log_mode(StateLogMode mode)
+{
+    m_state_log_mode = mode;
+}
+
+void JhsAirConditioner::set_state_log_level(int level)
+{
+    m_state_log_level = level;
+}
+
+#ifdef USE_JHS_AC_CAPTURE
+void JhsAirConditioner::set_capture_buffer_size(uint32_t size)
+{
+    m_capture_buffer_size = size;
+}
+
+void JhsAirConditioner::start_capture()
+{
+    if (!m_capture.start(App.get_loop_component_start_time())) {
+        ESP_LOGW(TAG, "Capture buffer is not allocated, set capture_buffer_size option");
+        return;
+    }
+    ESP_LOGI(TAG, "UART capture started");
+}
+
+void JhsAirConditioner::stop_capture()
+{
+    m_capture.stop();
+    ESP_LOGI(TAG, "UART capture stopped, %u bytes captured", m_capture.get_size());
+}
+
+void JhsAirConditioner::dump_capture()
+{
+    static constexpr uint32_t BYTES_PER_LINE = 32;
+    const uint8_t *data = m_capture.get_data();
+    const uint32_t size = m_capture.get_size();
+
+    ESP_LOGI(TAG, "UART capture (%u bytes%s):", size, m_capture.is_overflowed() ? ", truncated" : "");
+    for (uint32_t offset = 0; offset < size; offset += BYTES_PER_LINE)
+    {
+        const uint32_t length = std::min(size - offset, BYTES_PER_LINE);
+        ESP_LOGI(TAG, "  %s", format_hex(data + offset, length).c_str());
+    }
+}
+
+void JhsAirConditioner::start_replay(const std::vector<uint8_t> &data, ReplaySpeed speed)
+{
+    const uint32_t current_time = App.get_loop_component_start_time();
+    // without explicit data own capture is replayed
+    const bool started = data.empty() ?
+        m_replayer.start(m_capture.get_data(), m_capture.get_size(), speed, current_time) :
+        m_replayer.start(data.data(), data.size(), speed, current_time);
+
+    if (!started) {
+        ESP_LOGW(TAG, "Capture has invalid format, replay was not started");
+        return;
+    }
+    m_capture.stop();
+    m_replay_parser = PacketParser();
+    m_replayed_frames = 0;
+    enable_loop();
+    ESP_LOGI(TAG, "UART capture replay started");
+}
+#endif
+
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+void JhsAirConditioner::set_flight_recorder_size(uint32_t size)
+{
+    m_flight_recorder_size = size;
+}
+
+void JhsAirConditioner::dump_flight_recorder()
+{
+    const uint32_t current_time = App.get_loop_component_start_time();
+    ESP_LOGI(TAG, "Last %u of %u recorded frames:", m_flight_recorder.get_count(), m_flight_recorder.get_capacity());
+    m_flight_recorder.for_each([current_time](const FlightRecorder::Record &record) {
+        const char *type = record.type == FlightRecorder::RecordType::Sent ? "TX" : 
+            (record.type == FlightRecorder::RecordType::Rejected ? "RX rejected" : "RX");
+        ESP_LOGI(TAG, "  -%u ms %s %s", current_time - record.timestamp, type,
+            format_hex_pretty(record.data, record.length, ' ', false).c_str());
+    });
+}
+#endif
+
 climate::ClimateTraits JhsAirConditioner::traits()
 {
     return m_traits;
@@ -194,118 +511,591 @@ climate::ClimateTraits JhsAirConditioner::traits()
 
 void JhsAirConditioner::read_uart_data()
 {
+    PROFILE_STAGE(Read);
+#ifdef USE_JHS_AC_RX_TASK
+    if (m_rx_task_started)
+    {
+        read_rx_task_data();
+        return;
+    }
+#endif
+
+    // time is needed only by simulator and capture, when they are compiled in
+    [[maybe_unused]] const uint32_t current_time = App.get_loop_component_start_time();
+#ifdef USE_JHS_AC_SIMULATOR
+    if (m_simulator) {
+        m_simulator->update(current_time);
+    }
+#endif
+
+    uint32_t bytes_available = get_rx_available();
+    // free space may be split in two regions when ring buffer wraps around
+    while (bytes_available > 0 && !m_data_buffer.is_full())
+    {
+        auto span = m_data_buffer.write_span();
+        const uint32_t data_size = std::min(bytes_available, span.length);
+        if (!read_rx_data(span.data, data_size)) {
+            break;
+        }
+#ifdef USE_JHS_AC_CAPTURE
+        m_capture.record(CaptureDirection::Received, span.data, data_size, current_time);
+#endif
+        m_data_buffer.commit_write(data_size);
+        m_counters.add(DiagnosticCounters::Counter::BytesReceived, data_size);
+        bytes_available -= data_size;
+#ifdef USE_JHS_AC_PROFILING
+        if (m_profile_pipeline) {
+            m_profiler.add_bytes(data_size);
+        }
+#endif
+    }
+
+    // data left in UART until buffer is drained may be lost if UART FIFO overflows meanwhile
+    update_rx_overflow(bytes_available > 0 && m_data_buffer.is_full());
+    m_counters.update_max(DiagnosticCounters::Counter::RxBufferHighWater, m_data_buffer.size());
+}
+
+#ifdef USE_JHS_AC_RX_TASK
+void JhsAirConditioner::rx_task(void *arg)
+{
+    auto *component = static_cast<JhsAirConditioner*>(arg);
+    for (;;)
+    {
+        component->drain_uart_to_rx_ring();
+        vTaskDelay(pdMS_TO_TICKS(RX_TASK_POLL_INTERVAL_MS));
+    }
+}
+
+void JhsAirConditioner::drain_uart_to_rx_ring()
+{
+    // runs in reader task, so it may touch only UART and producer side of ring
     uint32_t bytes_available = static_cast<uint32_t>(available());
-    if (bytes_available > 0)
+    bool received = false;
+    while (bytes_available > 0 && !m_rx_ring.is_full())
     {
-        const uint32_t data_size = std::min(bytes_available, m_data_buffer.capacity() - m_data_buffer.size());
-        for (int32_t i = 0; i < data_size; i++) {
-            m_data_buffer.push(read()); // TODO replace it with single call
+        auto span = m_rx_ring.write_span();
+        const uint32_t data_size = std::min(bytes_available, span.length);
+        if (!read_array(span.data, data_size)) {
+            break;
         }
+        m_rx_ring.commit_write(data_size);
+        bytes_available -= data_size;
+        received = true;
+    }
+
+    if (received) {
+        enable_loop_soon_any_context();
     }
 }
 
+void JhsAirConditioner::read_rx_task_data()
+{
+    [[maybe_unused]] const uint32_t current_time = App.get_loop_component_start_time();
+    while (!m_rx_ring.is_empty() && !m_data_buffer.is_full())
+    {
+        auto source = m_rx_ring.read_span();
+        auto destination = m_data_buffer.write_span();
+        const uint32_t data_size = std::min(source.length, destination.length);
+        std::memcpy(destination.data, source.data, data_size);
+        m_rx_ring.consume(data_size);
+#ifdef USE_JHS_AC_CAPTURE
+        m_capture.record(CaptureDirection::Received, destination.data, data_size, current_time);
+#endif
+        m_data_buffer.commit_write(data_size);
+        m_counters.add(DiagnosticCounters::Counter::BytesReceived, data_size);
+#ifdef USE_JHS_AC_PROFILING
+        if (m_profile_pipeline) {
+            m_profiler.add_bytes(data_size);
+        }
+#endif
+    }
+
+    update_rx_overflow(m_rx_ring.is_full());
+    m_counters.update_max(DiagnosticCounters::Counter::RxBufferHighWater, m_rx_ring.size() + m_data_buffer.size());
+}
+#endif
+
+uint32_t JhsAirConditioner::get_rx_available()
+{
+#ifdef USE_JHS_AC_SIMULATOR
+    if (m_simulator) {
+        return m_simulator->available();
+    }
+#endif
+    return static_cast<uint32_t>(available());
+}
+
+bool JhsAirConditioner::read_rx_data(uint8_t *data, uint32_t length)
+{
+#ifdef USE_JHS_AC_SIMULATOR
+    if (m_simulator) {
+        return m_simulator->read(data, length) == length;
+    }
+#endif
+    return read_array(data, length);
+}
+
+void JhsAirConditioner::write_tx_data(const uint8_t *data, uint32_t length, uint32_t current_time)
+{
+#ifdef USE_JHS_AC_SIMULATOR
+    if (m_simulator)
+    {
+        m_simulator->write(data, length, current_time);
+        return;
+    }
+#endif
+    write_array(data, length);
+}
+
+void JhsAirConditioner::update_rx_overflow(bool overflow)
+{
+    // buffer stays full for several loop iterations while backlog is parsed, 
+    // which is counted as single overflow
+    if (overflow && !m_rx_overflow) {
+        m_counters.add(DiagnosticCounters::Counter::RxBufferOverflows);
+    }
+    m_rx_overflow = overflow;
+}
+
+#ifdef USE_JHS_AC_CAPTURE
+void JhsAirConditioner::replay_capture()
+{
+    // replayed data has own parser and decoded state, which are only logged, so replay
+    // doesn't publish anything, send commands or change diagnostics of actual UART link
+    const uint32_t current_time = App.get_loop_component_start_time();
+    uint8_t data[REPLAY_CHUNK_SIZE];
+    const uint32_t data_size = m_replayer.read(data, sizeof(data), current_time);
+    m_replay_parser.feed(data, data_size, [this](const uint8_t *packet, uint32_t) {
+        const AirConditionerState previous_state = m_replayed_state;
+        AirConditionerStateView(packet).decode(m_replayed_state);
+
+        const bool log_all_fields = m_state_log_mode == StateLogMode::Full || m_replayed_frames == 0;
+        char line[STATE_LOG_LINE_SIZE];
+        if (m_replayed_state.format(log_all_fields ? nullptr : &previous_state, line, sizeof(line)) > 0) {
+            ESP_LOGI(TAG, "Replayed AC state:%s", line);
+        }
+        m_replayed_frames++;
+        return true;
+    });
+
+    if (!m_replayer.is_active())
+    {
+        ESP_LOGI(TAG, "UART capture replay finished: %u frames, %u checksum errors, %u discarded bytes",
+            m_replayed_frames, m_replay_parser.get_checksum_errors(), m_replay_parser.get_discarded_bytes());
+    }
+}
+#endif
+
 void JhsAirConditioner::parse_received_data()
 {
-    while (!m_data_buffer.is_empty())
+    PROFILE_STAGE(Parse);
+    const uint32_t checksum_errors = m_parser.get_checksum_errors();
+    const uint32_t start_time = micros();
+    uint32_t parsed_bytes = 0;
+    uint32_t parsed_frames = 0;
+
+    // data which doesn't fit into budget stays in buffer until next loop iteration
+    auto budget_exhausted = [&]() {
+        return (m_loop_max_frames > 0 && parsed_frames >= m_loop_max_frames) ||
+            (m_loop_max_bytes > 0 && parsed_bytes >= m_loop_max_bytes) ||
+            (m_loop_max_time > 0 && micros() - start_time >= m_loop_max_time);
+    };
+
+    // frames with invalid checksum are the ones which tell most about bad link
+    auto on_rejected = [&](const uint8_t *packet, uint32_t packet_length) {
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+        m_flight_recorder.record(FlightRecorder::RecordType::Rejected, packet, packet_length, App.get_loop_component_start_time());
+#endif
+    };
+
+    while (!m_data_buffer.is_empty() && !budget_exhausted())
     {
-        m_parser.process_byte(m_data_buffer.pop().value());
-        if (m_parser.packet_ready())
-        {
-            uint32_t checksum = 0;
-            uint8_t packet_buffer[64];
-            const uint32_t packet_length = m_parser.read_packet(packet_buffer, sizeof(packet_buffer));
-            BinaryInputStream state_packet(packet_buffer, packet_length);
+        auto span = m_data_buffer.read_span();
+        const uint32_t length = m_loop_max_bytes > 0 ? std::min(span.length, m_loop_max_bytes - parsed_bytes) : span.length;
+        const uint32_t consumed = m_parser.feed(span.data, length, [&](const uint8_t *packet, uint32_t packet_length) {
+            handle_state_packet(packet, packet_length);
+            parsed_frames++;
+            return !budget_exhausted();
+        }, on_rejected);
+        m_data_buffer.consume(consumed);
+        parsed_bytes += consumed;
+    }
 
-            m_state.read_from_packet(state_packet, checksum);
-            dump_packet("Received packet", state_packet.get_buffer_addr(), state_packet.get_size());
+    if (m_parser.get_checksum_errors() != checksum_errors) {
+        ESP_LOGW(TAG, "Invalid AC state packet checksum, ignoring");
+    }
+}
 
-            if (validate_state_packet_checksum(state_packet, checksum)) 
-            {
-                dump_ac_state(m_state);
-                update_ac_state(m_state);
-            }
-            else {
-                ESP_LOGW(TAG, "Invalid AC state packet checksum, ignoring");
-            }
+void JhsAirConditioner::handle_state_packet(const uint8_t *data, uint32_t length)
+{
+    // parser passes only packets with valid checksum here
+    {
+        PROFILE_STAGE(Decode);
+        AirConditionerStateView state_view(data);
+        if (state_view.differs_from(m_state)) {
+            state_view.decode(m_state);
         }
     }
+
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+    m_flight_recorder.record(FlightRecorder::RecordType::Received, data, length, App.get_loop_component_start_time());
+#endif
+    dump_ac_state(m_state);
+
+    {
+        PROFILE_STAGE(Publish);
+        update_ac_state(m_optimistic_active ? get_predicted_state() : m_state);
+    }
+    if (m_persist_state) {
+        persist_state(m_state);
+    }
+    m_counters.add(DiagnosticCounters::Counter::FramesParsed);
+#ifdef USE_JHS_AC_PROFILING
+    if (m_profile_pipeline) {
+        m_profiler.add_frame();
+    }
+#endif
+
+    if (m_protocol_probe.is_active())
+    {
+        m_protocol_probe.handle_state(m_state);
+        if (m_protocol_probe.is_finished()) {
+            finish_protocol_probe();
+        }
+    }
+
+    const uint32_t current_time = App.get_loop_component_start_time();
+    if (m_frame_received) {
+        get_latency_histogram(LatencyMetric::FrameInterval).record(current_time - m_last_frame_time);
+    }
+    m_last_frame_time = current_time;
+    m_frame_received = true;
+
+    m_command_tracker.confirm(m_state, current_time, [this](const CommandDelivery &delivery) {
+        ESP_LOGD(TAG, "Command 0x%02X confirmed by AC in %u ms, retries: %u", 
+            static_cast<uint8_t>(delivery.function), delivery.latency, delivery.retries);
+        get_latency_histogram(LatencyMetric::ControlToConfirm).record(delivery.request_latency);
+        get_latency_histogram(LatencyMetric::Delivery).record(delivery.latency);
+    });
 }
 
 void JhsAirConditioner::send_queued_command()
 {
+    const uint32_t current_time = App.get_loop_component_start_time();
+    const bool interval_elapsed = current_time - m_last_command_send_time > TX_QUEUE_PACKETS_INTERVAL_MS;
+    if (m_tx_pacing == TxPacing::Fixed && !interval_elapsed) {
+        return;
+    }
+
+    // queued commands wait until protocol version is known
+    if (m_protocol_probe.is_active())
+    {
+        update_protocol_probe(current_time);
+        return;
+    }
+
+    if (retry_expired_command(current_time)) {
+        return;
+    }
+
+    // in adaptive mode commands are sent only when previous ones were confirmed
+    if (m_tx_pacing == TxPacing::Adaptive && !m_command_tracker.is_empty()) {
+        return;
+    }
+
     if (!m_tx_queue.is_empty())
     {
-        const uint32_t current_time = App.get_loop_component_start_time();
-        if (current_time - m_last_command_send_time > TX_QUEUE_PACKETS_INTERVAL_MS)
-        {
-            auto command_packet = m_tx_queue.pop();
-            send_packet_to_ac(command_packet->data, command_packet->length);
-            m_last_command_send_time = current_time;
-        }
+        auto scheduled = m_tx_queue.pop();
+        send_command_to_ac(scheduled->command);
+        m_command_tracker.track(scheduled->command, scheduled->queued_time, current_time);
+        get_latency_histogram(LatencyMetric::QueueWait).record(current_time - scheduled->queued_time);
+        m_last_command_send_time = current_time;
+    }
+}
+
+bool JhsAirConditioner::retry_expired_command(uint32_t current_time)
+{
+    auto command = m_command_tracker.find_expired(current_time, m_command_timeout);
+    if (command == nullptr) {
+        return false;
     }
+
+    const uint8_t function_code = static_cast<uint8_t>(command->command.function);
+    if (command->retries < m_command_max_retries)
+    {
+        command->retries++;
+        command->last_send_time = current_time;
+        m_counters.add(DiagnosticCounters::Counter::CommandRetries);
+        ESP_LOGW(TAG, "Command 0x%02X was not confirmed by AC, retrying (%u/%u)", 
+            function_code, command->retries, m_command_max_retries);
+        send_command_to_ac(command->command);
+        m_last_command_send_time = current_time;
+        return true;
+    }
+
+    ESP_LOGW(TAG, "Command 0x%02X was not confirmed by AC, giving up", function_code);
+    m_command_tracker.give_up(*command);
+    return false;
 }
 
-void JhsAirConditioner::add_packet_to_queue(const BinaryOutputStream &packet)
+void JhsAirConditioner::restore_protocol_version()
 {
-    if (m_tx_queue.is_full()) {
-        ESP_LOGE(TAG, "Command TX queue overflowed, last command ignored");
+    // preference is bound to entity, so several AC units keep their own versions
+    m_protocol_preference = global_preferences->make_preference<uint32_t>(get_object_id_hash() ^ PROTOCOL_PREFERENCE_KEY, true);
+    uint32_t version = 0;
+    if (m_protocol_preference.load(&version) && version >= 1 && version <= CommandFrames::PROTOCOL_VERSIONS_COUNT)
+    {
+        m_protocol_version = version;
+        ESP_LOGI(TAG, "Using previously detected protocol version %u", version);
+        return;
+    }
+
+    ESP_LOGI(TAG, "Protocol version is unknown, detecting it");
+    m_protocol_probe.start();
+}
+
+void JhsAirConditioner::update_protocol_probe(uint32_t current_time)
+{
+    CommandFrame frame;
+    if (m_protocol_probe.update(current_time, frame))
+    {
+        send_packet_to_ac(frame.data, sizeof(frame.data));
+        m_last_command_send_time = current_time;
+    }
+
+    if (m_protocol_probe.is_finished()) {
+        finish_protocol_probe();
+    }
+}
+
+void JhsAirConditioner::finish_protocol_probe()
+{
+    const uint32_t version = m_protocol_probe.get_detected_version();
+    if (version != 0)
+    {
+        ESP_LOGI(TAG, "Detected protocol version %u", version);
+        m_protocol_version = version;
+        m_protocol_preference.save(&version);
     }
     else
     {
-        CommandPacket command_packet;
-        constexpr uint32_t max_packet_size = sizeof(command_packet.data);
-        if (packet.get_length() <= max_packet_size)
-        {
-            command_packet.length = packet.get_length();
-            std::memcpy(command_packet.data, packet.get_buffer_addr(), packet.get_length());
-            m_tx_queue.push(command_packet);
-        }
-        else {
-            ESP_LOGE(TAG, "Trying to send command packet larger than %d bytes, ignoring", max_packet_size);
+        if (m_protocol_probe.is_setting_unsupported()) {
+            ESP_LOGW(TAG, "Reported temperature setting %u is out of valid range, so it can't be used to detect protocol version "
+                "(AC is off or uses Fahrenheit units)", m_state.temperature_setting);
         }
+        // version isn't saved, so detection is repeated on next boot
+        ESP_LOGW(TAG, "Failed to detect protocol version, falling back to version 1");
+        m_protocol_version = 1;
     }
 }
 
-void JhsAirConditioner::send_packet_to_ac(const uint8_t *data, uint32_t length)
+void JhsAirConditioner::restore_persisted_state()
 {
-    write_array(data, length);
-    dump_packet("Sent packet", data, length);
+    m_state_preference = global_preferences->make_preference<AirConditionerState>(get_object_id_hash() ^ STATE_PREFERENCE_KEY, true);
+    AirConditionerState state;
+    if (!m_state_preference.load(&state)) {
+        return;
+    }
+
+    // restored state is only shown until first report arrives, it's never compared
+    // with requests, see is_command_required()
+    ESP_LOGI(TAG, "Publishing last known AC state until AC reports actual one");
+    m_state_persistence.set_saved_state(state);
+    publish_climate_state(state);
+}
+
+void JhsAirConditioner::persist_state(const AirConditionerState &state)
+{
+    const uint32_t current_time = App.get_loop_component_start_time();
+    if (m_state_persistence.update(state, current_time))
+    {
+        ESP_LOGD(TAG, "Saving AC state to flash");
+        m_state_preference.save(&state);
+    }
 }
 
-void JhsAirConditioner::dump_packet(const char *title, const uint8_t *data, uint32_t length)
+void JhsAirConditioner::add_command_to_queue(const AirConditionerCommand &command)
 {
-#if VERBOSE_LOGGING == 1
-    char str[256] = {0};
-    char *pstr = str;
-    ESP_LOGD(TAG, "%s (%u bytes):", title, length);
-    for (int32_t i = 0; i < length; i++) {
-        pstr += sprintf(pstr, "%02X ", data[i]);
+    if (!CommandFrames::is_valid(command))
+    {
+        ESP_LOGE(TAG, "Trying to send command with invalid argument, ignoring");
+        m_counters.add(DiagnosticCounters::Counter::TxQueueDrops);
+        return;
+    }
+
+    enable_loop();
+    // replaced command is superseded rather than lost, so it's not counted as drop
+    if (m_tx_queue.schedule(command, App.get_loop_component_start_time())) {
+        ESP_LOGD(TAG, "Queued command 0x%02X replaced with newer one", static_cast<uint8_t>(command.function));
     }
-    ESP_LOGD(TAG, "%s", str);
+    m_counters.update_max(DiagnosticCounters::Counter::TxQueueHighWater, m_tx_queue.size());
+    // newer command supersedes unconfirmed one of the same function
+    m_command_tracker.cancel(command.function);
+}
+
+bool JhsAirConditioner::is_command_unconfirmed(AirConditionerCommand::Function function) const
+{
+    // request matching reported state still has to be sent, when queued or sent command 
+    // is going to change that state
+    return m_tx_queue.is_pending(function) || m_command_tracker.is_outstanding(function);
+}
+
+bool JhsAirConditioner::is_command_required(bool setting_differs, AirConditionerCommand::Function function) const
+{
+    // until first report arrives, AC state is unknown, restored one is only displayed,
+    // so every requested setting is sent
+    return !m_frame_received || setting_differs || is_command_unconfirmed(function);
+}
+
+void JhsAirConditioner::send_command_to_ac(const AirConditionerCommand &command)
+{
+    // frame is copied to stack, as frame table may be located in flash
+    CommandFrame frame;
+    if (CommandFrames::find(m_protocol_version, command, frame)) {
+        send_packet_to_ac(frame.data, sizeof(frame.data));
+    }
+}
+
+void JhsAirConditioner::send_packet_to_ac(const uint8_t *data, uint32_t length)
+{
+    const uint32_t current_time = App.get_loop_component_start_time();
+#ifdef USE_JHS_AC_CAPTURE
+    m_capture.record(CaptureDirection::Sent, data, length, current_time);
+#endif
+    write_tx_data(data, length, current_time);
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+    m_flight_recorder.record(FlightRecorder::RecordType::Sent, data, length, current_time);
 #endif
 }
 
-void JhsAirConditioner::dump_ac_state(const AirConditionerState &state)
+#ifdef USE_JHS_AC_PROFILING
+void JhsAirConditioner::dump_profiling_report()
 {
-    ESP_LOGD(TAG, "Air conditioner state:");
-    ESP_LOGD(TAG, "  Power: %s", state.power ? "On" : "Off");
-    ESP_LOGD(TAG, "  Mode: %s", AirConditionerState::get_mode_name(state.mode));
-    ESP_LOGD(TAG, "  Sleep mode: %s", state.sleep ? "On" : "Off");
-    ESP_LOGD(TAG, "  Oscillation: %s", state.oscillation ? "On" : "Off");
-    ESP_LOGD(TAG, "  Ambient temperature: %u", state.temperature_ambient);
-    ESP_LOGD(TAG, "  Temperature setting: %u", state.temperature_setting);
-    ESP_LOGD(TAG, "  Fan speed: %s", get_fan_speed_name(state.fan_speed));
-    ESP_LOGD(TAG, "  Temperature units: %s", (state.temperature_unit == AirConditionerState::TemperatureUnit::Celsius) ? "Celsius" : "Fahrenheit");
-    ESP_LOGD(TAG, "  Water tank state: %s", (state.water_tank_state == AirConditionerState::WaterTankState::Empty) ? "Empty" : "Full");
-#if VERBOSE_LOGGING == 1
-    ESP_LOGD(TAG, "  Byte [0A]: 0x%02X", state.byte_0A);
-    ESP_LOGD(TAG, "  Byte [0B]: 0x%02X", state.byte_0B);
-    ESP_LOGD(TAG, "  Byte [0C]: 0x%02X", state.byte_0C);
-    ESP_LOGD(TAG, "  Byte [0D]: 0x%02X", state.byte_0D);
+    const uint32_t bytes = m_profiler.get_bytes();
+    const uint32_t frames = m_profiler.get_frames();
+    const float ns_per_cycle = 1e9f / arch_get_cpu_freq_hz();
+    ESP_LOGI(TAG, "Receive pipeline profile: %u bytes, %u frames", bytes, frames);
+
+    for (uint8_t i = 0; i < static_cast<uint8_t>(PipelineProfiler::Stage::Count); i++)
+    {
+        const auto stage = static_cast<PipelineProfiler::Stage>(i);
+        const auto &statistics = m_profiler.get_statistics(stage);
+        const float total_ns = statistics.cycles * ns_per_cycle;
+        ESP_LOGI(TAG, "  %s: %u calls, %.0f ns/byte, %.0f ns/frame, %.0f cycles/frame, max %u cycles/call",
+            PipelineProfiler::get_stage_name(stage), statistics.calls,
+            bytes > 0 ? total_ns / bytes : 0.0f,
+            frames > 0 ? total_ns / frames : 0.0f,
+            frames > 0 ? static_cast<float>(statistics.cycles) / frames : 0.0f,
+            statistics.max_cycles);
+    }
+}
 #endif
+
+void JhsAirConditioner::dump_ac_state(const AirConditionerState &state)
+{
+    // level is checked here to not format state which logger would drop anyway
+    if (m_state_log_level == ESPHOME_LOG_LEVEL_NONE || m_state_log_level > ESPHOME_LOG_LEVEL) {
+        return;
+    }
+
+    const bool log_all_fields = m_state_log_mode == StateLogMode::Full || !m_state_logged;
+    char line[STATE_LOG_LINE_SIZE];
+    if (state.format(log_all_fields ? nullptr : &m_logged_state, line, sizeof(line)) == 0) {
+        return;
+    }
+
+    esp_log_printf_(m_state_log_level, TAG, __LINE__, "AC state:%s", line);
+    m_logged_state = state;
+    m_state_logged = true;
+}
+
+void JhsAirConditioner::publish_diagnostics()
+{
+    m_counters.set(DiagnosticCounters::Counter::ChecksumErrors, m_parser.get_checksum_errors());
+    m_counters.set(DiagnosticCounters::Counter::Resyncs, m_parser.get_resyncs());
+    m_counters.set(DiagnosticCounters::Counter::DiscardedBytes, m_parser.get_discarded_bytes());
+
+    for (uint8_t i = 0; i < static_cast<uint8_t>(DiagnosticCounters::Counter::Count); i++)
+    {
+        if (m_counter_sensors[i]) {
+            m_counter_sensors[i]->publish_state(m_counters.get(static_cast<DiagnosticCounters::Counter>(i)));
+        }
+    }
+
+    for (uint8_t i = 0; i < static_cast<uint8_t>(LatencyMetric::Count); i++)
+    {
+        const LatencyHistogram &histogram = m_latency_histograms[i];
+        for (uint8_t j = 0; j < static_cast<uint8_t>(LatencyHistogram::Statistic::Count); j++)
+        {
+            if (m_latency_sensors[i][j] && histogram.get_count() > 0) {
+                m_latency_sensors[i][j]->publish_state(histogram.get_statistic(static_cast<LatencyHistogram::Statistic>(j)));
+            }
+        }
+    }
+
+    // worst loop duration is reported per update interval, to make recent stalls visible
+    m_counters.set(DiagnosticCounters::Counter::MaxLoopDuration, 0);
+}
+
+AirConditionerState JhsAirConditioner::get_predicted_state() const
+{
+    // queued commands are newer than sent ones, so they are applied last
+    AirConditionerState state = m_state;
+    auto apply = [&state](const AirConditionerCommand &command) { command.apply_to(state); };
+    m_command_tracker.for_each_outstanding(apply);
+    m_tx_queue.for_each_pending(apply);
+    return state;
+}
+
+void JhsAirConditioner::update_optimistic_state(uint32_t current_time)
+{
+    const bool resolved = m_tx_queue.is_empty() && m_command_tracker.is_empty();
+    const bool deadline_expired = static_cast<int32_t>(current_time - m_optimistic_deadline) >= 0;
+    if (!resolved && !deadline_expired) {
+        return;
+    }
+
+    // commands which AC gave up on are no longer predicted, so published state differs from actual one
+    m_optimistic_active = false;
+    if (!resolved || !m_state.has_same_climate_settings(m_published_state))
+    {
+        ESP_LOGW(TAG, "AC didn't confirm requested state in time, rolling back to reported one");
+        m_counters.add(DiagnosticCounters::Counter::OptimisticRollbacks);
+    }
+    update_ac_state(m_state);
 }
 
 void JhsAirConditioner::update_ac_state(const AirConditionerState &state)
+{
+    // AC repeats same state most of the time, so publish only what actually changed,
+    // apart from periodic heartbeat which republishes everything
+    const uint32_t current_time = App.get_loop_component_start_time();
+    const bool heartbeat_expired = m_state_heartbeat_interval > 0 && 
+        current_time - m_last_publish_time >= m_state_heartbeat_interval;
+    const bool force_publish = !m_state_published || heartbeat_expired;
+
+    if (force_publish || !state.has_same_climate_settings(m_published_state))
+    {
+        if (!publish_climate_state(state)) {
+            return;
+        }
+    }
+
+    if (m_water_tank_sensor)
+    {
+        if (force_publish || state.water_tank_state != m_published_state.water_tank_state) {
+            m_water_tank_sensor->publish_state(state.water_tank_state == AirConditionerState::WaterTankState::Full);
+        }
+    }
+
+    if (force_publish) {
+        m_last_publish_time = current_time;
+    }
+    m_published_state = state;
+    m_state_published = true;
+}
+
+bool JhsAirConditioner::publish_climate_state(const AirConditionerState &state)
 {
     if (!state.power) {
         this->mode = climate::CLIMATE_MODE_OFF;
@@ -328,7 +1118,7 @@ void JhsAirConditioner::update_ac_state(const AirConditionerState &state)
             break;
         default:
             ESP_LOGW(TAG, "Unknown AC mode, state update was interrupted");
-            return;
+            return false;
         }
     }
 
@@ -349,21 +1139,7 @@ void JhsAirConditioner::update_ac_state(const AirConditionerState &state)
     }
 
     publish_state();
-
-    if (m_water_tank_sensor) {
-        m_water_tank_sensor->publish_state(state.water_tank_state == AirConditionerState::WaterTankState::Full);
-    }
-}
-
-bool JhsAirConditioner::validate_state_packet_checksum(const BinaryInputStream &stream, uint32_t checksum)
-{
-    uint32_t sum = 0;
-    BinaryInputStream packet(stream.get_buffer_addr(), stream.get_size());
-    packet.skip_bytes(1);
-    for (int32_t i = 0; i < PACKET_AC_STATE_CHECKSUM_LEN; i++) {
-        sum += packet.read<uint8_t>().value();
-    }
-    return (sum % 256) == checksum;
+    return true;
 }
 
 optional<AirConditionerState::Mode> JhsAirConditioner::get_mapped_ac_mode(climate::ClimateMode climate_mode) const
@@ -404,17 +1180,6 @@ optional<climate::ClimateFanMode> JhsAirConditioner::get_mapped_climate_fan_mode
     }
 }
 
-const char* JhsAirConditioner::get_fan_speed_name(AirConditionerState::FanSpeed fan_speed) const
-{
-    switch (fan_speed)
-    {
-        case AirConditionerState::FanSpeed::Low: return "Low";
-        case AirConditionerState::FanSpeed::Medium: return "Medium";
-        case AirConditionerState::FanSpeed::High: return "High";
-        default: return "Unknown";
-    }
-}
-
 optional<AirConditionerState::FanSpeed> JhsAirConditioner::get_mapped_fan_speed(climate::ClimateFanMode fan_mode) const
 {
     switch (fan_mode)
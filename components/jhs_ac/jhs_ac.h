@@ -3,69 +3,273 @@
 #include "esphome/components/climate/climate.h"
 #include "esphome/components/uart/uart.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/components/sensor/sensor.h"
 #include "esphome/core/log.h"
 #include "esphome/core/optional.h"
-#include "binary_output_stream.h"
+#include "esphome/core/preferences.h"
 #include "ac_state.h"
 #include "packet_parser.h"
 #include "ring_buffer.h"
+#include "command_scheduler.h"
+#include "command_tracker.h"
+#include "pipeline_profiler.h"
+#include "diagnostic_counters.h"
+#include "latency_histogram.h"
+#include "protocol_probe.h"
+#include "state_persistence.h"
+#ifdef USE_JHS_AC_RX_TASK
+#include "spsc_ring_buffer.h"
+#endif
+#ifdef USE_JHS_AC_SIMULATOR
+#include "ac_simulator.h"
+#endif
+#ifdef USE_JHS_AC_CAPTURE
+#include "uart_capture.h"
+#endif
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+#include "flight_recorder.h"
+#endif
+#include <vector>
 
 namespace esphome::jhs_ac {
 
-struct CommandPacket
+enum class TxPacing : uint8_t
 {
-    uint32_t length;
-    uint8_t data[18];
+    Fixed,      // commands are sent with constant interval
+    Adaptive    // next command is sent once AC state confirms previous ones
+};
+
+enum class LatencyMetric : uint8_t
+{
+    ControlToConfirm,   // from control request to state report which reflects it
+    QueueWait,          // from control request to command being sent
+    Delivery,           // from command being sent first time to state report which reflects it
+    FrameInterval,      // between consecutive state reports
+    Count
+};
+
+enum class StateLogMode : uint8_t
+{
+    Full,       // every received state is logged with all fields
+    Changes     // only fields which changed since previous state are logged
 };
 
 class JhsAirConditioner : public climate::Climate, public uart::UARTDevice, public esphome::Component
 {
 public:
     JhsAirConditioner() : 
+        m_state{},
         m_water_tank_sensor(nullptr), 
-        m_last_command_send_time(0) {};
+#ifdef USE_JHS_AC_SIMULATOR
+        m_simulator(nullptr),
+#endif
+        m_protocol_version(1),
+        m_rx_task_enabled(false),
+#ifdef USE_JHS_AC_RX_TASK
+        m_rx_task_started(false),
+#endif
+        m_last_command_send_time(0),
+        m_tx_pacing(TxPacing::Fixed),
+        m_command_timeout(1000),
+        m_command_max_retries(2),
+        m_loop_max_bytes(0),
+        m_loop_max_frames(0),
+        m_loop_max_time(0),
+        m_profile_pipeline(false),
+        m_state_published(false),
+        m_last_publish_time(0),
+        m_state_heartbeat_interval(0),
+        m_persist_state(false),
+        m_optimistic(false),
+        m_optimistic_timeout(0),
+        m_optimistic_active(false),
+        m_optimistic_deadline(0),
+#ifdef USE_JHS_AC_CAPTURE
+        m_capture_buffer_size(0),
+        m_replayed_frames(0),
+#endif
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+        m_flight_recorder_size(0),
+#endif
+        m_state_log_mode(StateLogMode::Changes),
+        m_state_log_level(ESPHOME_LOG_LEVEL_DEBUG),
+        m_state_logged(false),
+        m_rx_overflow(false),
+        m_counter_sensors{},
+        m_diagnostics_update_interval(0),
+        m_latency_sensors{},
+        m_last_frame_time(0),
+        m_frame_received(false) {};
 
     static constexpr const char *TAG = "jhs-ac";
     static constexpr float MIN_VALID_TEMPERATURE = 16.0f;
     static constexpr float MAX_VALID_TEMPERATURE = 31.0f;
     static constexpr float TEMPERATURE_STEP = 1.0f;
-    static constexpr uint8_t PACKET_AC_STATE_CHECKSUM_LEN = 15;
     static constexpr uint32_t TX_QUEUE_PACKETS_INTERVAL_MS = 100;
+    static constexpr uint32_t PROFILING_REPORT_INTERVAL_MS = 60000;
+    static constexpr uint32_t PROTOCOL_VERSION_AUTO = 0;
+    static constexpr uint32_t PROTOCOL_PREFERENCE_KEY = 0x4A485350;
+    static constexpr uint32_t STATE_PREFERENCE_KEY = 0x4A485353;
+    static constexpr uint32_t RX_TASK_POLL_INTERVAL_MS = 5;
+    static constexpr uint32_t RX_TASK_STACK_SIZE = 2048;
+    static constexpr uint32_t RX_TASK_PRIORITY = 5;
+    static constexpr uint32_t RX_TASK_BUFFER_SIZE = 1024;
+    static constexpr uint32_t STATE_LOG_LINE_SIZE = 256;
+    static constexpr uint32_t REPLAY_CHUNK_SIZE = 128;
 
     void setup() override;
     void loop() override;
     void dump_config() override;
     void control(const climate::ClimateCall &call) override;
     float get_setup_priority() const override;
+    void set_protocol_version(uint32_t version);
+    void set_rx_task(bool enabled);
+    void set_profile_pipeline(bool enabled);
     void set_water_tank_sensor(binary_sensor::BinarySensor *sensor);
+    void set_counter_sensor(DiagnosticCounters::Counter counter, sensor::Sensor *sensor);
+    void set_diagnostics_update_interval(uint32_t interval_ms);
+    void set_latency_sensor(LatencyMetric metric, LatencyHistogram::Statistic statistic, sensor::Sensor *sensor);
+    void reset_latency_histograms();
+#ifdef USE_JHS_AC_SIMULATOR
+    void set_simulator(AirConditionerSimulator *simulator);
+#endif
+    void set_state_heartbeat_interval(uint32_t interval_ms);
+    void set_persist_state(bool persist);
+    void set_optimistic(bool optimistic);
+    void set_optimistic_timeout(uint32_t timeout_ms);
+    void set_state_save_delay(uint32_t delay_ms);
+    void set_tx_pacing(TxPacing pacing);
+    void set_command_timeout(uint32_t timeout_ms);
+    void set_command_max_retries(uint32_t retries);
+    void set_loop_budget(uint32_t max_bytes, uint32_t max_frames, uint32_t max_time_us);
+    void set_state_log_mode(StateLogMode mode);
+    void set_state_log_level(int level);
+#ifdef USE_JHS_AC_CAPTURE
+    void set_capture_buffer_size(uint32_t size);
+    void start_capture();
+    void stop_capture();
+    void dump_capture();
+    void start_replay(const std::vector<uint8_t> &data, ReplaySpeed speed);
+#endif
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+    void set_flight_recorder_size(uint32_t size);
+    void dump_flight_recorder();
+#endif
     void add_supported_mode(climate::ClimateMode mode);
     void add_supported_fan_mode(climate::ClimateFanMode fan_mode);
     void add_supported_swing_mode(climate::ClimateSwingMode swing_mode);
 
 protected:
     climate::ClimateTraits traits() override;
+    bool is_idle() const;
+    bool is_rx_task_started() const;
+    bool is_simulated() const;
+#ifdef USE_JHS_AC_RX_TASK
+    static void rx_task(void *arg);
+    void drain_uart_to_rx_ring();
+    void read_rx_task_data();
+#endif
     void read_uart_data();
+    uint32_t get_rx_available();
+    bool read_rx_data(uint8_t *data, uint32_t length);
+    void write_tx_data(const uint8_t *data, uint32_t length, uint32_t current_time);
+#ifdef USE_JHS_AC_CAPTURE
+    void replay_capture();
+#endif
+    void update_rx_overflow(bool overflow);
     void parse_received_data();
+    void handle_state_packet(const uint8_t *data, uint32_t length);
     void send_queued_command();
-    void add_packet_to_queue(const BinaryOutputStream &packet);
+    bool retry_expired_command(uint32_t current_time);
+    void restore_protocol_version();
+    void update_protocol_probe(uint32_t current_time);
+    void finish_protocol_probe();
+    void restore_persisted_state();
+    void persist_state(const AirConditionerState &state);
+    void add_command_to_queue(const AirConditionerCommand &command);
+    bool is_command_unconfirmed(AirConditionerCommand::Function function) const;
+    bool is_command_required(bool setting_differs, AirConditionerCommand::Function function) const;
+    void send_command_to_ac(const AirConditionerCommand &command);
     void send_packet_to_ac(const uint8_t *data, uint32_t length);
-    void dump_packet(const char *title, const uint8_t *data, uint32_t length);
     void dump_ac_state(const AirConditionerState &state);
+#ifdef USE_JHS_AC_PROFILING
+    void dump_profiling_report();
+#endif
+    void publish_diagnostics();
+    LatencyHistogram &get_latency_histogram(LatencyMetric metric) { return m_latency_histograms[static_cast<uint8_t>(metric)]; }
+    AirConditionerState get_predicted_state() const;
+    void update_optimistic_state(uint32_t current_time);
     void update_ac_state(const AirConditionerState &state);
-    bool validate_state_packet_checksum(const BinaryInputStream &stream, uint32_t checksum);
+    bool publish_climate_state(const AirConditionerState &state);
 
     optional<AirConditionerState::Mode> get_mapped_ac_mode(climate::ClimateMode climate_mode) const;
     optional<AirConditionerState::FanSpeed> get_mapped_fan_speed(climate::ClimateFanMode fan_mode) const;
     optional<climate::ClimateFanMode> get_mapped_climate_fan_mode(AirConditionerState::FanSpeed fan_speed) const;
-    const char* get_fan_speed_name(AirConditionerState::FanSpeed fan_speed) const;
 
 private:
     AirConditionerState m_state;
     PacketParser m_parser;
     binary_sensor::BinarySensor *m_water_tank_sensor;
+#ifdef USE_JHS_AC_SIMULATOR
+    AirConditionerSimulator *m_simulator;
+#endif
+    uint32_t m_protocol_version;
+    ProtocolProbe m_protocol_probe;
+    ESPPreferenceObject m_protocol_preference;
     RingBuffer<uint8_t, 128> m_data_buffer;
-    RingBuffer<CommandPacket, 8> m_tx_queue;
+    bool m_rx_task_enabled;
+#ifdef USE_JHS_AC_RX_TASK
+    SpscRingBuffer<uint8_t, RX_TASK_BUFFER_SIZE> m_rx_ring;
+    bool m_rx_task_started;
+#endif
+    CommandScheduler m_tx_queue;
     uint32_t m_last_command_send_time;
+    TxPacing m_tx_pacing;
+    uint32_t m_command_timeout;
+    uint32_t m_command_max_retries;
+    uint32_t m_loop_max_bytes;
+    uint32_t m_loop_max_frames;
+    uint32_t m_loop_max_time;
+    CommandTracker m_command_tracker;
+    bool m_profile_pipeline;
+#ifdef USE_JHS_AC_PROFILING
+    PipelineProfiler m_profiler;
+#endif
+    AirConditionerState m_published_state;
+    bool m_state_published;
+    uint32_t m_last_publish_time;
+    uint32_t m_state_heartbeat_interval;
+    bool m_persist_state;
+    StatePersistence m_state_persistence;
+    ESPPreferenceObject m_state_preference;
+    bool m_optimistic;
+    uint32_t m_optimistic_timeout;
+    bool m_optimistic_active;
+    uint32_t m_optimistic_deadline;
+#ifdef USE_JHS_AC_CAPTURE
+    uint32_t m_capture_buffer_size;
+    CaptureRecorder m_capture;
+    CaptureReplayer m_replayer;
+    PacketParser m_replay_parser;
+    AirConditionerState m_replayed_state;
+    uint32_t m_replayed_frames;
+#endif
+#ifdef USE_JHS_AC_FLIGHT_RECORDER
+    uint32_t m_flight_recorder_size;
+    FlightRecorder m_flight_recorder;
+#endif
+    StateLogMode m_state_log_mode;
+    int m_state_log_level;
+    bool m_state_logged;
+    AirConditionerState m_logged_state;
+    DiagnosticCounters m_counters;
+    bool m_rx_overflow;
+    sensor::Sensor *m_counter_sensors[static_cast<uint8_t>(DiagnosticCounters::Counter::Count)];
+    uint32_t m_diagnostics_update_interval;
+    LatencyHistogram m_latency_histograms[static_cast<uint8_t>(LatencyMetric::Count)];
+    sensor::Sensor *m_latency_sensors[static_cast<uint8_t>(LatencyMetric::Count)][static_cast<uint8_t>(LatencyHistogram::Statistic::Count)];
+    uint32_t m_last_frame_time;
+    bool m_frame_received;
     climate::ClimateTraits m_traits;
     climate::ClimateModeMask m_supported_modes;
     climate::ClimateFanModeMask m_supported_fan_modes;
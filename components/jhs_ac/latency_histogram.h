@@ -0,0 +1,71 @@
+#pragma once
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+// Fixed bucket histogram of durations in milliseconds. Percentiles are estimated 
+// as upper bound of bucket they fall into, maximum is tracked exactly.
+class LatencyHistogram
+{
+public:
+    enum class Statistic : uint8_t
+    {
+        P50,
+        P95,
+        Max,
+        Count
+    };
+
+    static constexpr uint32_t BUCKET_BOUNDS[] = {
+        5, 10, 20, 50, 100, 200, 300, 500, 750, 1000, 1500, 2000, 3000, 5000, 10000, UINT32_MAX
+    };
+    static constexpr uint32_t BUCKETS_COUNT = sizeof(BUCKET_BOUNDS) / sizeof(BUCKET_BOUNDS[0]);
+
+    LatencyHistogram() : m_buckets{}, m_count(0), m_max(0) {}
+
+    void record(uint32_t value)
+    {
+        uint32_t index = 0;
+        while (value > BUCKET_BOUNDS[index]) {
+            index++;
+        }
+        m_buckets[index]++;
+        m_count++;
+        m_max = (value > m_max) ? value : m_max;
+    }
+
+    uint32_t get_percentile(uint32_t percent) const
+    {
+        // rank of sample which percentile falls to, rounded up
+        const uint64_t rank = (static_cast<uint64_t>(m_count) * percent + 99) / 100;
+        uint64_t cumulative = 0;
+        for (uint32_t i = 0; i < BUCKETS_COUNT; i++)
+        {
+            cumulative += m_buckets[i];
+            if (cumulative >= rank && cumulative > 0) {
+                return (BUCKET_BOUNDS[i] < m_max) ? BUCKET_BOUNDS[i] : m_max;
+            }
+        }
+        return m_max;
+    }
+
+    uint32_t get_statistic(Statistic statistic) const
+    {
+        switch (statistic)
+        {
+            case Statistic::P50: return get_percentile(50);
+            case Statistic::P95: return get_percentile(95);
+            default: return m_max;
+        }
+    }
+
+    uint32_t get_count() const { return m_count; }
+    void reset() { *this = LatencyHistogram(); }
+
+private:
+    uint32_t m_buckets[BUCKETS_COUNT];
+    uint32_t m_count;
+    uint32_t m_max;
+};
+
+} // namespace esphome::jhs_ac
@@ -1,54 +1,94 @@
 #include "packet_parser.h"
+#include <algorithm>
 #include <cstring>
 
 namespace esphome::jhs_ac {
 
-void PacketParser::process_byte(uint8_t data)
+uint32_t PacketParser::scan(const uint8_t *data, uint32_t length)
 {
     if (m_current_state == State::Pending) 
     {
-        if (data == PACKET_START_MARKER) 
+        auto marker = static_cast<const uint8_t*>(std::memchr(data, PACKET_START_MARKER, length));
+        if (marker == nullptr) 
         {
-            m_current_state = State::Parsing;
-            m_buffer.push_back(data);
+            m_discarded_bytes += length;
+            return length;
         }
+        const uint32_t skipped = static_cast<uint32_t>(marker - data);
+        m_discarded_bytes += skipped;
+        m_current_state = State::Parsing;
+        append_data(marker, 1);
+        return skipped + 1;
     }
     else if (m_current_state == State::Parsing) 
     {
-        if (m_buffer.size() >= PACKET_AC_STATE_SIZE) 
+        const uint32_t count = std::min<uint32_t>(length, PACKET_AC_STATE_SIZE - m_buffer.size());
+        append_data(data, count);
+        if (m_buffer.size() == PACKET_AC_STATE_SIZE)
         {
-            m_buffer.clear();
-            m_current_state = State::Pending;
-        }
-        else 
-        {
-            if (data == PACKET_END_MARKER)
-            {
-                if (m_buffer.size() == PACKET_AC_STATE_SIZE - 1) {
-                    m_current_state = State::Finished;
-                }
-            }
-            m_buffer.push_back(data);
+            m_current_state = validate_packet() ? State::Finished : State::Rejected;
         }
+        return count;
+    }
+    return 0;
+}
+
+void PacketParser::append_data(const uint8_t *data, uint32_t count)
+{
+    // running checksum covers bytes between start marker and checksum byte
+    const uint32_t offset = m_buffer.size();
+    const uint32_t checksum_end = PACKET_AC_STATE_CHECKSUM_LEN + 1;
+    const uint32_t skip = (offset == 0) ? 1 : 0;
+    for (uint32_t i = skip; i < count && offset + i < checksum_end; i++) {
+        m_checksum += data[i];
     }
+    m_buffer.append(data, count);
 }
 
-bool PacketParser::packet_ready() const
+bool PacketParser::validate_packet()
 {
-    return m_current_state == State::Finished;
+    const uint8_t *packet = m_buffer.data();
+    if (packet[PACKET_AC_STATE_SIZE - 1] != PACKET_END_MARKER) {
+        return false;
+    }
+    if (packet[PACKET_AC_STATE_CHECKSUM_LEN + 1] != (m_checksum % 256))
+    {
+        m_checksum_errors++;
+        return false;
+    }
+    return true;
 }
 
-uint32_t PacketParser::read_packet(uint8_t *buffer, uint32_t buffer_size)
+void PacketParser::resynchronize()
 {
-    const uint32_t data_size = m_buffer.size() * m_buffer.element_size();
-    if (m_current_state == State::Finished && data_size <= buffer_size)
+    // another packet may begin inside rejected one, so continue from next start marker 
+    // candidate instead of dropping all collected bytes
+    const uint8_t *packet = m_buffer.data();
+    m_resyncs++;
+    auto marker = static_cast<const uint8_t*>(std::memchr(packet + 1, PACKET_START_MARKER, m_buffer.size() - 1));
+    if (marker != nullptr) 
     {
-        std::memcpy(buffer, &m_buffer[0], data_size);
-        m_current_state = State::Pending;
+        uint8_t remaining[PACKET_AC_STATE_SIZE];
+        const uint32_t remaining_size = m_buffer.size() - static_cast<uint32_t>(marker - packet);
+        m_discarded_bytes += static_cast<uint32_t>(marker - packet);
+        std::memcpy(remaining, marker, remaining_size);
         m_buffer.clear();
-        return data_size;
+        m_checksum = 0;
+        m_current_state = State::Parsing;
+        append_data(remaining, remaining_size);
     }
-    return 0;
+    else 
+    {
+        m_discarded_bytes += m_buffer.size();
+        reset();
+    }
+}
+
+void PacketParser::reset()
+{
+    m_current_state = State::Pending;
+    m_checksum = 0;
+    m_buffer.clear();
 }
 
 } // namespace esphome::jhs_ac
@@ -7,25 +7,74 @@ namespace esphome::jhs_ac {
 class PacketParser
 {
 public:
-    PacketParser() : m_current_state(State::Pending) {};
+    PacketParser() : 
+        m_current_state(State::Pending),
+        m_checksum(0),
+        m_checksum_errors(0),
+        m_resyncs(0),
+        m_discarded_bytes(0) {};
 
-    void process_byte(uint8_t data);
-    bool packet_ready() const;
-    uint32_t read_packet(uint8_t *buffer, uint32_t buffer_size);
+    // scans data block, callback is invoked for every complete packet found in it and returns 
+    // whether scanning should go on, returns count of bytes consumed from data block
+    template<class Callback> uint32_t feed(const uint8_t *data, uint32_t length, Callback &&on_packet)
+    {
+        return feed(data, length, on_packet, [](const uint8_t *, uint32_t) {});
+    }
+
+    // same, but packets of full size rejected because of end marker or checksum are passed to second callback
+    template<class Callback, class RejectedCallback> 
+    uint32_t feed(const uint8_t *data, uint32_t length, Callback &&on_packet, RejectedCallback &&on_rejected)
+    {
+        uint32_t offset = 0;
+        while (offset < length)
+        {
+            offset += scan(data + offset, length - offset);
+            if (m_current_state == State::Rejected)
+            {
+                on_rejected(m_buffer.data(), m_buffer.size());
+                resynchronize();
+            }
+            else if (m_current_state == State::Finished)
+            {
+                const bool proceed = on_packet(m_buffer.data(), m_buffer.size());
+                reset();
+                if (!proceed) {
+                    break;
+                }
+            }
+        }
+        return offset;
+    }
+
+    uint32_t get_checksum_errors() const { return m_checksum_errors; }
+    uint32_t get_resyncs() const { return m_resyncs; }
+    uint32_t get_discarded_bytes() const { return m_discarded_bytes; }
 
 private:
     static constexpr uint8_t PACKET_START_MARKER = 0xA5;
     static constexpr uint8_t PACKET_END_MARKER = 0xF5;
     static constexpr uint8_t PACKET_AC_STATE_SIZE = 18;
+    static constexpr uint8_t PACKET_AC_STATE_CHECKSUM_LEN = 15;
 
     enum class State
     {
         Pending,
         Parsing,
+        Rejected,
         Finished
     };
 
+    uint32_t scan(const uint8_t *data, uint32_t length);
+    void append_data(const uint8_t *data, uint32_t count);
+    bool validate_packet();
+    void resynchronize();
+    void reset();
+
     State m_current_state;
+    uint32_t m_checksum;
+    uint32_t m_checksum_errors;
+    uint32_t m_resyncs;
+    uint32_t m_discarded_bytes;
     FixedVector<uint8_t, 32> m_buffer;
 };
 
@@ -0,0 +1,76 @@
+#pragma once
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+// Accumulates CPU cycles spent in every stage of receive pipeline. Stages may be nested,
+// in that case each stage is accounted only for its own cycles, without nested ones.
+class PipelineProfiler
+{
+public:
+    enum class Stage : uint8_t
+    {
+        Read,
+        Parse,
+        Decode,
+        Publish,
+        Count
+    };
+
+    struct StageStatistics
+    {
+        uint64_t cycles;
+        uint32_t calls;
+        uint32_t max_cycles;
+    };
+
+    struct StageMark
+    {
+        uint32_t start_cycles;
+        uint64_t recorded_cycles;
+    };
+
+    PipelineProfiler() : m_stages{}, m_recorded_cycles(0), m_bytes(0), m_frames(0) {}
+
+    StageMark begin(uint32_t current_cycles) const { return StageMark{current_cycles, m_recorded_cycles}; }
+
+    void end(Stage stage, const StageMark &mark, uint32_t current_cycles)
+    {
+        const uint32_t elapsed = current_cycles - mark.start_cycles;
+        const uint32_t nested = static_cast<uint32_t>(m_recorded_cycles - mark.recorded_cycles);
+        const uint32_t own_cycles = elapsed - nested;
+        StageStatistics &statistics = m_stages[static_cast<uint8_t>(stage)];
+        statistics.cycles += own_cycles;
+        statistics.calls++;
+        statistics.max_cycles = (own_cycles > statistics.max_cycles) ? own_cycles : statistics.max_cycles;
+        m_recorded_cycles += own_cycles;
+    }
+
+    void add_bytes(uint32_t count) { m_bytes += count; }
+    void add_frame() { m_frames++; }
+    uint32_t get_bytes() const { return m_bytes; }
+    uint32_t get_frames() const { return m_frames; }
+    const StageStatistics &get_statistics(Stage stage) const { return m_stages[static_cast<uint8_t>(stage)]; }
+
+    void reset() { *this = PipelineProfiler(); }
+
+    static const char *get_stage_name(Stage stage)
+    {
+        switch (stage)
+        {
+            case Stage::Read: return "Read";
+            case Stage::Parse: return "Parse";
+            case Stage::Decode: return "Decode";
+            case Stage::Publish: return "Publish";
+            default: return "Unknown";
+        }
+    }
+
+private:
+    StageStatistics m_stages[static_cast<uint8_t>(Stage::Count)];
+    uint64_t m_recorded_cycles;
+    uint32_t m_bytes;
+    uint32_t m_frames;
+};
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,104 @@
+#include "protocol_probe.h"
+
+namespace esphome::jhs_ac {
+
+void ProtocolProbe::start()
+{
+    m_stage = Stage::WaitingState;
+    m_detected_version = 0;
+    m_attempts = 0;
+    m_setting_unsupported = false;
+}
+
+bool ProtocolProbe::update(uint32_t current_time, CommandFrame &frame)
+{
+    switch (m_stage)
+    {
+        case Stage::SendingProbe:
+            m_stage = Stage::WaitingResponse;
+            m_stage_time = current_time;
+            return CommandFrames::find(m_version, AirConditionerCommand::temperature(m_probe_setting), frame);
+
+        case Stage::WaitingResponse:
+            // AC may still apply probe after timeout, so result is taken from next state report
+            if (current_time - m_stage_time >= RESPONSE_TIMEOUT_MS)
+            {
+                m_stage = Stage::Verifying;
+                m_stage_time = current_time;
+            }
+            return false;
+
+        case Stage::Verifying:
+            // AC stopped reporting its state, so whole sequence is repeated from fresh state
+            if (current_time - m_stage_time >= RESPONSE_TIMEOUT_MS)
+            {
+                m_attempts++;
+                m_stage = m_attempts < MAX_ATTEMPTS ? Stage::WaitingState : Stage::Finished;
+            }
+            return false;
+
+        case Stage::Restoring:
+            m_stage = Stage::Finished;
+            return CommandFrames::find(m_detected_version, AirConditionerCommand::temperature(m_original_setting), frame);
+
+        default:
+            return false;
+    }
+}
+
+void ProtocolProbe::handle_state(const AirConditionerState &state)
+{
+    if (m_stage == Stage::WaitingState)
+    {
+        // setting out of valid range (Fahrenheit units, or zero while AC is off) could be neither 
+        // probed nor restored, so waiting for response to probe would be pointless
+        const AirConditionerCommand original = AirConditionerCommand::temperature(state.temperature_setting);
+        if (!CommandFrames::is_valid(original))
+        {
+            m_setting_unsupported = true;
+            m_stage = Stage::Finished;
+            return;
+        }
+
+        m_original_setting = original.argument;
+        const uint8_t max_setting = CommandFrames::get_argument_range(AirConditionerCommand::Function::Temperature).max;
+        m_probe_setting = m_original_setting < max_setting ? m_original_setting + 1 : m_original_setting - 1;
+        m_version = 1;
+        m_stage = Stage::SendingProbe;
+    }
+    else if ((m_stage == Stage::WaitingResponse || m_stage == Stage::Verifying) && state.temperature_setting == m_probe_setting)
+    {
+        // stages are entered only after probe of current version was sent, so report is response to it
+        m_detected_version = m_version;
+        m_stage = Stage::Restoring;
+    }
+    else if (m_stage == Stage::Verifying)
+    {
+        // setting changed by someone else can't tell anything about probe, so it's started anew
+        if (state.temperature_setting == m_original_setting) {
+            probe_next_version();
+        }
+        else
+        {
+            m_attempts++;
+            m_stage = m_attempts < MAX_ATTEMPTS ? Stage::WaitingState : Stage::Finished;
+        }
+    }
+}
+
+void ProtocolProbe::probe_next_version()
+{
+    if (m_version < CommandFrames::PROTOCOL_VERSIONS_COUNT)
+    {
+        m_version++;
+        m_stage = Stage::SendingProbe;
+    }
+    else
+    {
+        // AC may have missed probe, so whole sequence is repeated from fresh state
+        m_attempts++;
+        m_stage = m_attempts < MAX_ATTEMPTS ? Stage::WaitingState : Stage::Finished;
+    }
+}
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,64 @@
+#pragma once
+#include "ac_state.h"
+#include "command_frames.h"
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+// Detects protocol version of connected AC. Temperature setting is changed by one degree 
+// with command encoded as version 1, then as version 2 if AC didn't apply it, and setting
+// is restored afterwards using version which worked. Before next version is probed, fresh
+// state report has to show original setting, so probe applied late isn't credited to it.
+class ProtocolProbe
+{
+public:
+    static constexpr uint32_t RESPONSE_TIMEOUT_MS = 3000;
+    static constexpr uint32_t MAX_ATTEMPTS = 3;
+
+    ProtocolProbe() : 
+        m_stage(Stage::Idle),
+        m_version(0),
+        m_detected_version(0),
+        m_attempts(0),
+        m_setting_unsupported(false),
+        m_original_setting(0),
+        m_probe_setting(0),
+        m_stage_time(0) {}
+
+    void start();
+    // returns true when given frame should be sent to AC now
+    bool update(uint32_t current_time, CommandFrame &frame);
+    void handle_state(const AirConditionerState &state);
+
+    bool is_active() const { return m_stage != Stage::Idle && m_stage != Stage::Finished; }
+    bool is_finished() const { return m_stage == Stage::Finished; }
+    // zero when version was not detected within all attempts
+    uint32_t get_detected_version() const { return m_detected_version; }
+    // detection is given up at once when reported setting can't be changed by command
+    bool is_setting_unsupported() const { return m_setting_unsupported; }
+
+private:
+    void probe_next_version();
+
+    enum class Stage : uint8_t
+    {
+        Idle,
+        WaitingState,
+        SendingProbe,
+        WaitingResponse,
+        Verifying,
+        Restoring,
+        Finished
+    };
+
+    Stage m_stage;
+    uint32_t m_version;
+    uint32_t m_detected_version;
+    uint32_t m_attempts;
+    bool m_setting_unsupported;
+    uint8_t m_original_setting;
+    uint8_t m_probe_setting;
+    uint32_t m_stage_time;
+};
+
+} // namespace esphome::jhs_ac
@@ -1,5 +1,5 @@
 #pragma once
-#include "esphome/core/optional.h"
+#include <optional>
 #include <stdint.h>
 
 namespace esphome::jhs_ac {
@@ -8,6 +8,13 @@ template<class T, uint32_t N>
 class RingBuffer 
 {
 public:
+    // contiguous region of buffer storage, buffer may expose up to two of them when wrapped
+    struct Span
+    {
+        T *data;
+        uint32_t length;
+    };
+
     RingBuffer() : m_buffer{}, m_head(0), m_tail(0), m_count(0) {}
 
     bool is_empty() const { return m_count == 0; }
@@ -26,22 +33,49 @@ public:
             return false;
         }
         m_buffer[m_head] = value;
-        m_head = (m_head + 1) % N;
+        m_head = wrap_index(m_head + 1);
         m_count++;
         return true;
     }
 
-    optional<T> pop() 
+    std::optional<T> pop() 
     {
         if (is_empty()) {
-            return nullopt;
+            return std::nullopt;
         }
         T result = m_buffer[m_tail];
-        m_tail = (m_tail + 1) % N;
+        m_tail = wrap_index(m_tail + 1);
         m_count--;
         return result;
     }
 
+    // returns first contiguous free region, call commit_write() after filling it
+    Span write_span()
+    {
+        const uint32_t free_space = N - m_count;
+        const uint32_t until_end = N - m_head;
+        return Span{&m_buffer[m_head], (free_space < until_end) ? free_space : until_end};
+    }
+
+    void commit_write(uint32_t count)
+    {
+        m_head = wrap_index(m_head + count);
+        m_count += count;
+    }
+
+    // returns first contiguous region of stored elements, call consume() after processing it
+    Span read_span()
+    {
+        const uint32_t until_end = N - m_tail;
+        return Span{&m_buffer[m_tail], (m_count < until_end) ? m_count : until_end};
+    }
+
+    void consume(uint32_t count)
+    {
+        m_tail = wrap_index(m_tail + count);
+        m_count -= count;
+    }
+
     void clear() 
     {
         m_head = 0;
@@ -50,6 +84,8 @@ public:
     }
 
 private:
+    static uint32_t wrap_index(uint32_t index) { return (index >= N) ? index - N : index; }
+
     T m_buffer[N];
     uint32_t m_head;
     uint32_t m_tail;
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+// Lock-free variant of RingBuffer for exactly one producer and one consumer thread.
+// Producer uses only write_span() and commit_write(), consumer uses read_span() and consume().
+template<class T, uint32_t N>
+class SpscRingBuffer
+{
+public:
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Capacity should be power of two.");
+
+    struct Span
+    {
+        T *data;
+        uint32_t length;
+    };
+
+    SpscRingBuffer() : m_buffer{}, m_head(0), m_tail(0) {}
+
+    bool is_empty() const { return size() == 0; }
+    bool is_full() const { return size() == N; }
+    uint32_t size() const { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+    uint32_t capacity() const { return N; }
+
+    // returns first contiguous free region, call commit_write() after filling it
+    Span write_span()
+    {
+        const uint32_t head = m_head.load(std::memory_order_relaxed);
+        const uint32_t free_space = N - (head - m_tail.load(std::memory_order_acquire));
+        const uint32_t until_end = N - (head & MASK);
+        return Span{&m_buffer[head & MASK], (free_space < until_end) ? free_space : until_end};
+    }
+
+    void commit_write(uint32_t count)
+    {
+        // release makes written elements visible to consumer before new head
+        m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // returns first contiguous region of stored elements, call consume() after processing it
+    Span read_span()
+    {
+        const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        const uint32_t count = m_head.load(std::memory_order_acquire) - tail;
+        const uint32_t until_end = N - (tail & MASK);
+        return Span{&m_buffer[tail & MASK], (count < until_end) ? count : until_end};
+    }
+
+    void consume(uint32_t count)
+    {
+        // release keeps processing of elements before producer may overwrite them
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+private:
+    static constexpr uint32_t MASK = N - 1;
+
+    T m_buffer[N];
+    // indices grow freely and wrap around together with uint32_t, so full and empty states differ
+    std::atomic<uint32_t> m_head;
+    std::atomic<uint32_t> m_tail;
+};
+
+} // namespace esphome::jhs_ac
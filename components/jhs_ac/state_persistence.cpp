@@ -0,0 +1,35 @@
+#include "state_persistence.h"
+
+namespace esphome::jhs_ac {
+
+void StatePersistence::set_saved_state(const AirConditionerState &state)
+{
+    m_saved_state = state;
+    m_saved = true;
+    m_dirty = false;
+}
+
+bool StatePersistence::update(const AirConditionerState &state, uint32_t current_time)
+{
+    if (m_saved && state.has_same_persistent_settings(m_saved_state))
+    {
+        m_dirty = false;
+        return false;
+    }
+
+    // stability period starts over with every change of persistent fields
+    if (!m_dirty || !state.has_same_persistent_settings(m_pending_state))
+    {
+        m_pending_state = state;
+        m_change_time = current_time;
+        m_dirty = true;
+    }
+
+    if (current_time - m_change_time < m_save_delay) {
+        return false;
+    }
+    set_saved_state(state);
+    return true;
+}
+
+} // namespace esphome::jhs_ac
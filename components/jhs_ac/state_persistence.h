@@ -0,0 +1,36 @@
+#pragma once
+#include "ac_state.h"
+#include <stdint.h>
+
+namespace esphome::jhs_ac {
+
+// Decides when AC state should be written to flash. State is saved only when its 
+// persistent fields differ from saved ones and stay unchanged for save delay.
+class StatePersistence
+{
+public:
+    StatePersistence() : 
+        m_saved_state{},
+        m_pending_state{},
+        m_save_delay(0),
+        m_change_time(0),
+        m_saved(false),
+        m_dirty(false) {}
+
+    void set_save_delay(uint32_t delay_ms) { m_save_delay = delay_ms; }
+    void set_saved_state(const AirConditionerState &state);
+    // returns true when given state should be saved now
+    bool update(const AirConditionerState &state, uint32_t current_time);
+
+    uint32_t get_save_delay() const { return m_save_delay; }
+
+private:
+    AirConditionerState m_saved_state;
+    AirConditionerState m_pending_state;
+    uint32_t m_save_delay;
+    uint32_t m_change_time;
+    bool m_saved;
+    bool m_dirty;
+};
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,139 @@
+#include "uart_capture.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome::jhs_ac {
+
+void CaptureRecorder::allocate(uint32_t capacity)
+{
+    m_buffer.reset(capacity > 0 ? new uint8_t[capacity] : nullptr);
+    m_capacity = capacity;
+    m_size = 0;
+    m_recording = false;
+}
+
+bool CaptureRecorder::start(uint32_t current_time)
+{
+    if (m_capacity < HEADER_SIZE) {
+        return false;
+    }
+
+    std::memcpy(m_buffer.get(), FORMAT_MAGIC, sizeof(FORMAT_MAGIC));
+    m_buffer[sizeof(FORMAT_MAGIC)] = FORMAT_VERSION;
+    m_size = HEADER_SIZE;
+    m_last_time = current_time;
+    m_recording = true;
+    m_overflowed = false;
+    return true;
+}
+
+void CaptureRecorder::record(CaptureDirection direction, const uint8_t *data, uint32_t length, uint32_t current_time)
+{
+    while (m_recording && length > 0)
+    {
+        const uint32_t chunk = std::min<uint32_t>(length, UINT8_MAX);
+        if (m_size + RECORD_HEADER_SIZE + chunk > m_capacity)
+        {
+            // recording stops when buffer is full, to keep beginning of captured session
+            m_recording = false;
+            m_overflowed = true;
+            return;
+        }
+
+        const uint32_t delta = std::min<uint32_t>(current_time - m_last_time, UINT16_MAX);
+        uint8_t *record = m_buffer.get() + m_size;
+        record[0] = static_cast<uint8_t>(direction);
+        record[1] = delta & 0xFF;
+        record[2] = (delta >> 8) & 0xFF;
+        record[3] = chunk;
+        std::memcpy(record + RECORD_HEADER_SIZE, data, chunk);
+
+        m_size += RECORD_HEADER_SIZE + chunk;
+        m_last_time = current_time;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+CaptureReader::CaptureReader(const uint8_t *data, uint32_t size) :
+    m_data(data),
+    m_size(size),
+    m_offset(CaptureRecorder::HEADER_SIZE),
+    m_timestamp(0),
+    m_valid(false)
+{
+    if (data != nullptr && size >= CaptureRecorder::HEADER_SIZE)
+    {
+        m_valid = std::memcmp(data, CaptureRecorder::FORMAT_MAGIC, sizeof(CaptureRecorder::FORMAT_MAGIC)) == 0 &&
+            data[sizeof(CaptureRecorder::FORMAT_MAGIC)] == CaptureRecorder::FORMAT_VERSION;
+    }
+}
+
+bool CaptureReader::next(CaptureRecord &record)
+{
+    if (!m_valid || m_offset + CaptureRecorder::RECORD_HEADER_SIZE > m_size) {
+        return false;
+    }
+
+    const uint8_t *header = m_data + m_offset;
+    const uint32_t length = header[3];
+    if (m_offset + CaptureRecorder::RECORD_HEADER_SIZE + length > m_size) {
+        return false;
+    }
+
+    m_timestamp += header[1] | (header[2] << 8);
+    record.direction = static_cast<CaptureDirection>(header[0]);
+    record.timestamp = m_timestamp;
+    record.data = header + CaptureRecorder::RECORD_HEADER_SIZE;
+    record.length = length;
+    m_offset += CaptureRecorder::RECORD_HEADER_SIZE + length;
+    return true;
+}
+
+bool CaptureReplayer::start(const uint8_t *data, uint32_t size, ReplaySpeed speed, uint32_t current_time)
+{
+    // capture is copied, so recorder buffer can be reused while replay is active
+    m_capture.assign(data, data + size);
+    m_reader = CaptureReader(m_capture.data(), m_capture.size());
+    m_record_offset = 0;
+    m_start_time = current_time;
+    m_speed = speed;
+    m_active = m_reader.is_valid() && next_received_record();
+    return m_reader.is_valid();
+}
+
+uint32_t CaptureReplayer::read(uint8_t *data, uint32_t length, uint32_t current_time)
+{
+    uint32_t count = 0;
+    while (m_active && count < length)
+    {
+        if (m_speed == ReplaySpeed::Original && current_time - m_start_time < m_record.timestamp) {
+            break;
+        }
+
+        const uint32_t chunk = std::min(length - count, m_record.length - m_record_offset);
+        std::memcpy(data + count, m_record.data + m_record_offset, chunk);
+        m_record_offset += chunk;
+        count += chunk;
+
+        if (m_record_offset == m_record.length)
+        {
+            m_record_offset = 0;
+            m_active = next_received_record();
+        }
+    }
+    return count;
+}
+
+bool CaptureReplayer::next_received_record()
+{
+    while (m_reader.next(m_record))
+    {
+        if (m_record.direction == CaptureDirection::Received && m_record.length > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,102 @@
+#pragma once
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+namespace esphome::jhs_ac {
+
+// Capture consists of header (magic and format version) followed by records:
+//   [1 byte] direction, 0 for received data and 1 for sent data
+//   [2 bytes] milliseconds elapsed since previous record, little endian, saturated
+//   [1 byte] data length
+//   [N bytes] data
+enum class CaptureDirection : uint8_t
+{
+    Received = 0,
+    Sent = 1
+};
+
+struct CaptureRecord
+{
+    CaptureDirection direction;
+    uint32_t timestamp;
+    const uint8_t *data;
+    uint32_t length;
+};
+
+class CaptureRecorder
+{
+public:
+    static constexpr uint8_t FORMAT_MAGIC[4] = {'J', 'H', 'S', 'C'};
+    static constexpr uint8_t FORMAT_VERSION = 1;
+    static constexpr uint32_t HEADER_SIZE = sizeof(FORMAT_MAGIC) + 1;
+    static constexpr uint32_t RECORD_HEADER_SIZE = 4;
+
+    CaptureRecorder() : m_capacity(0), m_size(0), m_last_time(0), m_recording(false), m_overflowed(false) {}
+
+    void allocate(uint32_t capacity);
+    bool start(uint32_t current_time);
+    void stop() { m_recording = false; }
+    void record(CaptureDirection direction, const uint8_t *data, uint32_t length, uint32_t current_time);
+
+    bool is_recording() const { return m_recording; }
+    bool is_overflowed() const { return m_overflowed; }
+    uint32_t get_capacity() const { return m_capacity; }
+    uint32_t get_size() const { return m_size; }
+    const uint8_t *get_data() const { return m_buffer.get(); }
+
+private:
+    std::unique_ptr<uint8_t[]> m_buffer;
+    uint32_t m_capacity;
+    uint32_t m_size;
+    uint32_t m_last_time;
+    bool m_recording;
+    bool m_overflowed;
+};
+
+class CaptureReader
+{
+public:
+    CaptureReader(const uint8_t *data, uint32_t size);
+
+    bool is_valid() const { return m_valid; }
+    bool next(CaptureRecord &record);
+
+private:
+    const uint8_t *m_data;
+    uint32_t m_size;
+    uint32_t m_offset;
+    uint32_t m_timestamp;
+    bool m_valid;
+};
+
+enum class ReplaySpeed : uint8_t
+{
+    Original,   // received data is fed with original timing
+    Maximum     // received data is fed as fast as component consumes it
+};
+
+// Feeds received data from capture back as if it came from UART, sent data is skipped
+class CaptureReplayer
+{
+public:
+    CaptureReplayer() : m_reader(nullptr, 0), m_record{}, m_record_offset(0), m_start_time(0), m_speed(ReplaySpeed::Original), m_active(false) {}
+
+    bool start(const uint8_t *data, uint32_t size, ReplaySpeed speed, uint32_t current_time);
+    void stop() { m_active = false; }
+    bool is_active() const { return m_active; }
+    uint32_t read(uint8_t *data, uint32_t length, uint32_t current_time);
+
+private:
+    bool next_received_record();
+
+    std::vector<uint8_t> m_capture;
+    CaptureReader m_reader;
+    CaptureRecord m_record;
+    uint32_t m_record_offset;
+    uint32_t m_start_time;
+    ReplaySpeed m_speed;
+    bool m_active;
+};
+
+} // namespace esphome::jhs_ac
@@ -0,0 +1,36 @@
+#include "test.h"
+#include "command_frames.h"
+#include <cstring>
+
+using namespace esphome::jhs_ac;
+
+TEST(every_valid_command_has_frame_in_both_versions)
+{
+    uint32_t frames = 0;
+    for (uint32_t version = 1; version <= CommandFrames::PROTOCOL_VERSIONS_COUNT; version++)
+    {
+        for (const CommandArgumentRange &range : COMMAND_ARGUMENT_RANGES)
+        {
+            for (uint32_t argument = range.min; argument <= range.max; argument++)
+            {
+                const AirConditionerCommand command = {range.function, static_cast<uint8_t>(argument)};
+                const CommandFrame expected = CommandFrames::make_frame(version, range.function, argument);
+                CommandFrame frame = {};
+                EXPECT(CommandFrames::find(version, command, frame));
+                EXPECT(std::memcmp(frame.data, expected.data, sizeof(frame.data)) == 0);
+                frames++;
+            }
+        }
+    }
+    EXPECT_EQ(frames, CommandFrames::FRAMES_COUNT);
+}
+
+TEST(invalid_command_or_version_has_no_frame)
+{
+    CommandFrame frame = {};
+    EXPECT(!CommandFrames::find(1, AirConditionerCommand::temperature(15), frame));
+    EXPECT(!CommandFrames::find(2, AirConditionerCommand::temperature(32), frame));
+    EXPECT(!CommandFrames::find(1, {AirConditionerCommand::Function::Mode, 0}, frame));
+    EXPECT(!CommandFrames::find(0, AirConditionerCommand::power(true), frame));
+    EXPECT(!CommandFrames::find(3, AirConditionerCommand::power(true), frame));
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "jhs_ac.h"
+#include "ac_simulator.h"
+#include "ac_state_view.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include <cstdint>
+#include <vector>
+
+namespace jhs_ac_test {
+
+using namespace esphome;
+using namespace esphome::jhs_ac;
+
+// builds state report frame as AC main board sends it
+inline std::vector<uint8_t> make_state_frame(const AirConditionerState &state)
+{
+    std::vector<uint8_t> packet(AirConditionerStateView::PACKET_SIZE);
+    AirConditionerSimulator::encode_state_report(state, packet.data());
+    return packet;
+}
+
+inline AirConditionerState make_state(bool power, uint32_t temperature_setting)
+{
+    AirConditionerState state{};
+    state.power = power;
+    state.mode = AirConditionerState::Mode::Cool;
+    state.fan_speed = AirConditionerState::FanSpeed::Low;
+    state.temperature_ambient = 26;
+    state.temperature_setting = temperature_setting;
+    state.temperature_unit = AirConditionerState::TemperatureUnit::Celsius;
+    state.water_tank_state = AirConditionerState::WaterTankState::Empty;
+    return state;
+}
+
+// component wired to simulated AC unit through mock UART, 
+// as it would be on device with real AC connected
+class ComponentFixture
+{
+public:
+    ComponentFixture(uint32_t object_id_hash = 0x4A48) : m_climate_publishes(0)
+    {
+        mock::set_time_us(1000000);
+        mock::clear_log_messages();
+        App.clear_components();
+
+        component.set_uart_parent(&uart);
+        component.set_object_id_hash(object_id_hash);
+        component.add_supported_mode(climate::CLIMATE_MODE_COOL);
+        component.add_supported_mode(climate::CLIMATE_MODE_HEAT);
+        component.add_supported_mode(climate::CLIMATE_MODE_DRY);
+        component.add_supported_mode(climate::CLIMATE_MODE_FAN_ONLY);
+        component.add_supported_fan_mode(climate::CLIMATE_FAN_LOW);
+        component.add_supported_fan_mode(climate::CLIMATE_FAN_MEDIUM);
+        component.add_supported_fan_mode(climate::CLIMATE_FAN_HIGH);
+        component.add_supported_swing_mode(climate::CLIMATE_SWING_VERTICAL);
+        component.add_on_state_callback([this](climate::Climate &) { m_climate_publishes++; });
+        App.register_component(&component);
+    }
+
+    void start() { App.setup(); }
+
+    // simulated AC is attached to UART, unless test feeds UART by itself
+    void run(uint32_t duration_ms, bool ac_connected = true, uint32_t step_ms = 10)
+    {
+        for (uint32_t elapsed = 0; elapsed < duration_ms; elapsed += step_ms)
+        {
+            if (ac_connected) {
+                exchange_with_ac();
+            }
+            App.loop();
+            mock::advance_time_ms(step_ms);
+        }
+    }
+
+    void exchange_with_ac()
+    {
+        const uint32_t current_time = millis();
+        const std::vector<uint8_t> &sent = uart.get_tx_data();
+        simulator.write(sent.data(), sent.size(), current_time);
+        uart.clear_tx_data();
+        simulator.update(current_time);
+
+        uint8_t buffer[64];
+        while (uint32_t length = simulator.read(buffer, sizeof(buffer))) {
+            uart.inject_rx(buffer, length);
+        }
+    }
+
+    uint32_t get_climate_publishes() const { return m_climate_publishes; }
+
+    uart::UARTComponent uart;
+    AirConditionerSimulator simulator;
+    JhsAirConditioner component;
+
+private:
+    uint32_t m_climate_publishes;
+};
+
+} // namespace jhs_ac_test
@@ -0,0 +1,182 @@
+#include "test.h"
+#include "component_fixture.h"
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/core/log.h"
+
+using namespace jhs_ac_test;
+
+TEST(reported_state_is_published)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.run(1500);
+
+    EXPECT(fixture.get_climate_publishes() >= 1);
+    EXPECT_EQ(fixture.component.mode, climate::CLIMATE_MODE_OFF);
+    EXPECT_EQ(fixture.component.target_temperature, 24.0f);
+    EXPECT_EQ(fixture.component.current_temperature, 26.0f);
+}
+
+TEST(unchanged_state_is_published_once)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.run(10500);
+
+    // simulated AC reports same state every second
+    EXPECT_EQ(fixture.get_climate_publishes(), 1u);
+}
+
+TEST(control_request_is_sent_and_confirmed)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.run(1500);
+
+    fixture.component.make_call().set_target_temperature(20.0f).perform();
+    fixture.run(3000);
+
+    EXPECT_EQ(fixture.component.target_temperature, 20.0f);
+    EXPECT_EQ(mock::count_log_messages("was not confirmed"), 0u);
+}
+
+TEST(command_frame_is_written_to_uart)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.uart.inject_rx(make_state_frame(make_state(false, 24)));
+    fixture.run(50, false);
+
+    fixture.component.make_call().set_target_temperature(20.0f).perform();
+    fixture.run(200, false);
+
+    const std::vector<uint8_t> expected = {0xA5, 0x14, 0x14, 0x14, 0x3C, 0xF5};
+    EXPECT(fixture.uart.get_tx_data() == expected);
+}
+
+TEST(turning_on_sends_power_before_mode)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.run(1500);
+
+    fixture.component.make_call().set_mode(climate::CLIMATE_MODE_HEAT).perform();
+    fixture.run(3000);
+
+    EXPECT_EQ(fixture.component.mode, climate::CLIMATE_MODE_HEAT);
+}
+
+TEST(request_before_first_report_is_sent)
+{
+    ComponentFixture fixture;
+    fixture.start();
+
+    // AC state isn't known yet, so request matching default state must not be skipped
+    fixture.component.make_call().set_preset(climate::CLIMATE_PRESET_NONE).perform();
+    fixture.run(200, false);
+
+    EXPECT(!fixture.uart.get_tx_data().empty());
+}
+
+TEST(water_tank_state_is_published)
+{
+    ComponentFixture fixture;
+    binary_sensor::BinarySensor water_tank;
+    fixture.component.set_water_tank_sensor(&water_tank);
+    fixture.start();
+
+    AirConditionerState state = make_state(true, 24);
+    state.water_tank_state = AirConditionerState::WaterTankState::Full;
+    fixture.uart.inject_rx(make_state_frame(state));
+    fixture.run(50, false);
+
+    EXPECT(water_tank.state);
+}
+
+TEST(fragmented_frames_are_assembled)
+{
+    ComponentFixture fixture;
+    fixture.start();
+
+    const std::vector<uint8_t> frame = make_state_frame(make_state(true, 27));
+    for (uint8_t byte : frame)
+    {
+        fixture.uart.inject_rx(&byte, 1);
+        fixture.run(10, false);
+    }
+
+    EXPECT_EQ(fixture.component.target_temperature, 27.0f);
+}
+
+TEST(received_frame_is_handled_in_next_loop_iteration)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.run(100, false);
+
+    fixture.uart.inject_rx(make_state_frame(make_state(true, 22)));
+    App.loop();
+    EXPECT_EQ(fixture.component.target_temperature, 22.0f);
+}
+
+TEST(reverting_unconfirmed_setting_is_sent)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.run(1500);
+
+    // second request matches reported state, but first one is already sent and unconfirmed
+    fixture.component.make_call().set_target_temperature(25.0f).perform();
+    fixture.run(150);
+    fixture.component.make_call().set_target_temperature(24.0f).perform();
+    fixture.run(5000);
+
+    EXPECT_EQ(fixture.component.target_temperature, 24.0f);
+    EXPECT_EQ(mock::count_log_messages("was not confirmed"), 0u);
+}
+
+TEST(turning_on_during_unconfirmed_power_off_is_sent)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.run(1500);
+    fixture.component.make_call().set_mode(climate::CLIMATE_MODE_COOL).perform();
+    fixture.run(3000);
+    EXPECT_EQ(fixture.component.mode, climate::CLIMATE_MODE_COOL);
+
+    fixture.component.make_call().set_mode(climate::CLIMATE_MODE_OFF).perform();
+    fixture.run(150);
+    fixture.component.make_call().set_mode(climate::CLIMATE_MODE_COOL).perform();
+    fixture.run(5000);
+
+    EXPECT_EQ(fixture.component.mode, climate::CLIMATE_MODE_COOL);
+}
+
+TEST(optimistic_state_follows_reverted_request)
+{
+    ComponentFixture fixture;
+    fixture.component.set_optimistic(true);
+    fixture.component.set_optimistic_timeout(10000);
+    fixture.start();
+    fixture.run(1500);
+
+    fixture.component.make_call().set_target_temperature(25.0f).perform();
+    EXPECT_EQ(fixture.component.target_temperature, 25.0f);
+    fixture.run(150);
+    fixture.component.make_call().set_target_temperature(24.0f).perform();
+    EXPECT_EQ(fixture.component.target_temperature, 24.0f);
+}
+
+TEST(simulator_replaces_uart)
+{
+    ComponentFixture fixture;
+    fixture.component.set_simulator(&fixture.simulator);
+    fixture.start();
+    fixture.run(1500, false);
+
+    fixture.component.make_call().set_target_temperature(20.0f).perform();
+    fixture.run(3000, false);
+
+    EXPECT_EQ(fixture.component.target_temperature, 20.0f);
+    EXPECT(fixture.uart.get_tx_data().empty());
+}
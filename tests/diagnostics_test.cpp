@@ -0,0 +1,82 @@
+#include "test.h"
+#include "component_fixture.h"
+#include "esphome/components/sensor/sensor.h"
+
+using namespace jhs_ac_test;
+
+TEST(rx_buffer_overflow_is_counted_once_per_episode)
+{
+    ComponentFixture fixture;
+    sensor::Sensor overflows;
+    fixture.component.set_counter_sensor(DiagnosticCounters::Counter::RxBufferOverflows, &overflows);
+    fixture.component.set_diagnostics_update_interval(1000);
+    // small parse budget keeps receive buffer full for many loop iterations
+    fixture.component.set_loop_budget(16, 0, 0);
+    fixture.start();
+
+    const std::vector<uint8_t> noise(400, 0x55);
+    fixture.uart.inject_rx(noise);
+    fixture.run(1500, false);
+    EXPECT_EQ(overflows.state, 1.0f);
+
+    fixture.uart.inject_rx(noise);
+    fixture.run(1000, false);
+    EXPECT_EQ(overflows.state, 2.0f);
+}
+
+TEST(replaced_command_is_not_counted_as_drop)
+{
+    ComponentFixture fixture;
+    sensor::Sensor drops;
+    fixture.component.set_counter_sensor(DiagnosticCounters::Counter::TxQueueDrops, &drops);
+    fixture.component.set_diagnostics_update_interval(1000);
+    fixture.start();
+    fixture.run(1500);
+
+    fixture.component.make_call().set_target_temperature(20.0f).perform();
+    fixture.component.make_call().set_target_temperature(21.0f).perform();
+    fixture.run(1000);
+    EXPECT_EQ(drops.state, 0.0f);
+
+    fixture.component.make_call().set_target_temperature(40.0f).perform();
+    fixture.run(1000);
+    EXPECT_EQ(drops.state, 1.0f);
+}
+
+TEST(command_retries_and_delivery_latency_are_reported)
+{
+    ComponentFixture fixture;
+    sensor::Sensor retries;
+    sensor::Sensor delivery_max;
+    fixture.component.set_counter_sensor(DiagnosticCounters::Counter::CommandRetries, &retries);
+    fixture.component.set_latency_sensor(LatencyMetric::Delivery, LatencyHistogram::Statistic::Max, &delivery_max);
+    fixture.component.set_diagnostics_update_interval(1000);
+    // AC applies command later than command timeout, so it's sent once more
+    fixture.simulator.set_reaction_delay(1500);
+    fixture.start();
+    fixture.run(1500);
+
+    fixture.component.make_call().set_target_temperature(20.0f).perform();
+    fixture.run(4000);
+    EXPECT_EQ(retries.state, 1.0f);
+    EXPECT(delivery_max.state >= 1500.0f);
+}
+
+TEST(flight_recorder_keeps_rejected_frames)
+{
+    ComponentFixture fixture;
+    fixture.component.set_flight_recorder_size(4);
+    fixture.start();
+
+    std::vector<uint8_t> frame = make_state_frame(make_state(true, 24));
+    fixture.uart.inject_rx(frame);
+    frame[AirConditionerStateView::OFFSET_CHECKSUM] ^= 0xFF;
+    fixture.uart.inject_rx(frame);
+    fixture.run(100, false);
+
+    mock::clear_log_messages();
+    fixture.component.dump_flight_recorder();
+    EXPECT_EQ(mock::count_log_messages("Last 2 of 4 recorded frames"), 1u);
+    EXPECT_EQ(mock::count_log_messages(" RX rejected A5 "), 1u);
+    EXPECT_EQ(mock::count_log_messages(" RX A5 "), 1u);
+}
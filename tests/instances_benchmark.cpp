@@ -0,0 +1,147 @@
+#include "jhs_ac.h"
+#include "ac_simulator.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Runs growing number of component instances, each talking to own simulated AC unit through
+// own mock UART, and prints host CPU time of their loops and RAM they take. Instances alternate
+// between protocol versions 1 and 2 and receive control request every few seconds.
+// Usage: instances_benchmark [simulated seconds]
+
+using namespace esphome;
+using namespace esphome::jhs_ac;
+
+namespace {
+
+bool g_count_allocations = false;
+size_t g_allocated_bytes = 0;
+
+} // namespace
+
+void *operator new(size_t size)
+{
+    if (g_count_allocations) {
+        g_allocated_bytes += size;
+    }
+    if (void *pointer = std::malloc(size > 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace {
+
+static constexpr uint32_t LOOP_INTERVAL_MS = 10;
+static constexpr uint32_t CONTROL_INTERVAL_MS = 5000;
+
+struct Instance
+{
+    explicit Instance(uint32_t index)
+    {
+        const uint32_t version = index % 2 + 1;
+        simulator.set_protocol_version(version);
+        component.set_protocol_version(version);
+        component.set_uart_parent(&uart);
+        component.set_object_id_hash(0x4A480000 + index);
+        component.add_supported_mode(climate::CLIMATE_MODE_COOL);
+        component.add_supported_fan_mode(climate::CLIMATE_FAN_LOW);
+        component.add_supported_fan_mode(climate::CLIMATE_FAN_HIGH);
+        App.register_component(&component);
+    }
+
+    void exchange_with_ac(uint32_t current_time)
+    {
+        const std::vector<uint8_t> &sent = uart.get_tx_data();
+        simulator.write(sent.data(), sent.size(), current_time);
+        uart.clear_tx_data();
+        simulator.update(current_time);
+
+        uint8_t buffer[64];
+        while (uint32_t length = simulator.read(buffer, sizeof(buffer))) {
+            uart.inject_rx(buffer, length);
+        }
+    }
+
+    uart::UARTComponent uart;
+    AirConditionerSimulator simulator;
+    JhsAirConditioner component;
+};
+
+void run_instances(uint32_t count, uint32_t duration_ms)
+{
+    mock::set_time_us(1000000);
+    mock::clear_log_messages();
+    App.clear_components();
+
+    std::vector<std::unique_ptr<Instance>> instances;
+    for (uint32_t i = 0; i < count; i++) {
+        instances.push_back(std::make_unique<Instance>(i));
+    }
+
+    // setup allocates buffers and traits of component, it's called directly, so allocations made
+    // by dump_config() logging and later ones of host mocks aren't counted
+    g_allocated_bytes = 0;
+    g_count_allocations = true;
+    for (const auto &instance : instances) {
+        instance->component.setup();
+    }
+    g_count_allocations = false;
+    const size_t setup_allocated_bytes = g_allocated_bytes;
+
+    std::chrono::nanoseconds loop_time{0};
+    uint32_t iterations = 0;
+    for (uint32_t elapsed = 0; elapsed < duration_ms; elapsed += LOOP_INTERVAL_MS)
+    {
+        if (elapsed % CONTROL_INTERVAL_MS == 0)
+        {
+            const float temperature = (elapsed / CONTROL_INTERVAL_MS) % 2 ? 20.0f : 24.0f;
+            for (const auto &instance : instances) {
+                instance->component.make_call().set_mode(climate::CLIMATE_MODE_COOL).set_target_temperature(temperature).perform();
+            }
+        }
+        for (const auto &instance : instances) {
+            instance->exchange_with_ac(millis());
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        App.loop();
+        loop_time += std::chrono::steady_clock::now() - start;
+        iterations++;
+        mock::advance_time_ms(LOOP_INTERVAL_MS);
+    }
+
+    const double ns_per_iteration = static_cast<double>(loop_time.count()) / iterations;
+    std::printf("%u instances: %.0f ns/iteration, %.0f ns/iteration per instance, "
+        "%zu bytes object size + %zu bytes allocated by setup() per instance, %u commands confirmed\n",
+        count, ns_per_iteration, ns_per_iteration / count, sizeof(JhsAirConditioner),
+        setup_allocated_bytes / count, mock::count_log_messages("confirmed by AC"));
+    App.clear_components();
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const uint32_t duration_s = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 60;
+    for (uint32_t count : {1, 2, 3, 4, 8}) {
+        run_instances(count, duration_s * 1000);
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "fixed_vector.h"
+#include <stdint.h>
+
+namespace jhs_ac_test {
+
+// byte-at-a-time parser which component used before PacketParser::feed(), 
+// kept as reference for equivalence tests
+class LegacyPacketParser
+{
+public:
+    LegacyPacketParser() : m_current_state(State::Pending) {};
+
+    void process_byte(uint8_t data);
+    bool packet_ready() const;
+    uint32_t read_packet(uint8_t *buffer, uint32_t buffer_size);
+    // checksum used to be validated by component after packet was read
+    static bool validate_checksum(const uint8_t *packet);
+
+private:
+    static constexpr uint8_t PACKET_START_MARKER = 0xA5;
+    static constexpr uint8_t PACKET_END_MARKER = 0xF5;
+    static constexpr uint8_t PACKET_AC_STATE_SIZE = 18;
+    static constexpr uint8_t PACKET_AC_STATE_CHECKSUM_LEN = 15;
+
+    enum class State
+    {
+        Pending,
+        Parsing,
+        Finished
+    };
+
+    State m_current_state;
+    esphome::jhs_ac::FixedVector<uint8_t, 32> m_buffer;
+};
+
+} // namespace jhs_ac_test
@@ -0,0 +1,27 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include "esphome/core/component.h"
+
+namespace esphome::binary_sensor {
+
+class BinarySensor : public EntityBase
+{
+public:
+    void publish_state(bool new_state)
+    {
+        state = new_state;
+        for (auto &callback : callbacks_) {
+            callback(new_state);
+        }
+    }
+
+    void add_on_state_callback(std::function<void(bool)> &&callback) { callbacks_.push_back(std::move(callback)); }
+
+    bool state{false};
+
+private:
+    std::vector<std::function<void(bool)>> callbacks_;
+};
+
+} // namespace esphome::binary_sensor
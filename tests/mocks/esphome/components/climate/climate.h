@@ -0,0 +1,163 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <set>
+#include <vector>
+#include "esphome/core/component.h"
+#include "esphome/core/optional.h"
+
+namespace esphome::climate {
+
+enum ClimateMode : uint8_t
+{
+    CLIMATE_MODE_OFF,
+    CLIMATE_MODE_HEAT_COOL,
+    CLIMATE_MODE_COOL,
+    CLIMATE_MODE_HEAT,
+    CLIMATE_MODE_FAN_ONLY,
+    CLIMATE_MODE_DRY,
+    CLIMATE_MODE_AUTO,
+};
+
+enum ClimateFanMode : uint8_t
+{
+    CLIMATE_FAN_ON,
+    CLIMATE_FAN_OFF,
+    CLIMATE_FAN_AUTO,
+    CLIMATE_FAN_LOW,
+    CLIMATE_FAN_MEDIUM,
+    CLIMATE_FAN_HIGH,
+    CLIMATE_FAN_MIDDLE,
+    CLIMATE_FAN_FOCUS,
+    CLIMATE_FAN_DIFFUSE,
+    CLIMATE_FAN_QUIET,
+};
+
+enum ClimateSwingMode : uint8_t
+{
+    CLIMATE_SWING_OFF,
+    CLIMATE_SWING_BOTH,
+    CLIMATE_SWING_VERTICAL,
+    CLIMATE_SWING_HORIZONTAL,
+};
+
+enum ClimatePreset : uint8_t
+{
+    CLIMATE_PRESET_NONE,
+    CLIMATE_PRESET_HOME,
+    CLIMATE_PRESET_AWAY,
+    CLIMATE_PRESET_BOOST,
+    CLIMATE_PRESET_COMFORT,
+    CLIMATE_PRESET_ECO,
+    CLIMATE_PRESET_SLEEP,
+    CLIMATE_PRESET_ACTIVITY,
+};
+
+enum ClimateFeature : uint32_t
+{
+    CLIMATE_SUPPORTS_CURRENT_TEMPERATURE = 1 << 0,
+};
+
+using ClimateModeMask = std::set<ClimateMode>;
+using ClimateFanModeMask = std::set<ClimateFanMode>;
+using ClimateSwingModeMask = std::set<ClimateSwingMode>;
+using ClimatePresetMask = std::set<ClimatePreset>;
+
+class ClimateTraits
+{
+public:
+    void set_visual_min_temperature(float temperature) { visual_min_temperature_ = temperature; }
+    void set_visual_max_temperature(float temperature) { visual_max_temperature_ = temperature; }
+    void set_visual_temperature_step(float step) { visual_temperature_step_ = step; }
+    void add_feature_flags(uint32_t flags) { feature_flags_ |= flags; }
+    void set_supported_modes(ClimateModeMask modes) { supported_modes_ = modes; }
+    void set_supported_fan_modes(ClimateFanModeMask modes) { supported_fan_modes_ = modes; }
+    void set_supported_swing_modes(ClimateSwingModeMask modes) { supported_swing_modes_ = modes; }
+    void set_supported_presets(std::initializer_list<ClimatePreset> presets) { supported_presets_ = presets; }
+
+    float get_visual_min_temperature() const { return visual_min_temperature_; }
+    float get_visual_max_temperature() const { return visual_max_temperature_; }
+    const ClimateModeMask &get_supported_modes() const { return supported_modes_; }
+    const ClimateFanModeMask &get_supported_fan_modes() const { return supported_fan_modes_; }
+    const ClimateSwingModeMask &get_supported_swing_modes() const { return supported_swing_modes_; }
+    const ClimatePresetMask &get_supported_presets() const { return supported_presets_; }
+
+private:
+    float visual_min_temperature_{10.0f};
+    float visual_max_temperature_{30.0f};
+    float visual_temperature_step_{0.1f};
+    uint32_t feature_flags_{0};
+    ClimateModeMask supported_modes_;
+    ClimateFanModeMask supported_fan_modes_;
+    ClimateSwingModeMask supported_swing_modes_;
+    ClimatePresetMask supported_presets_;
+};
+
+class Climate;
+
+class ClimateCall
+{
+public:
+    explicit ClimateCall(Climate *parent) : parent_(parent) {}
+
+    ClimateCall &set_mode(ClimateMode mode) { mode_ = mode; return *this; }
+    ClimateCall &set_target_temperature(float temperature) { target_temperature_ = temperature; return *this; }
+    ClimateCall &set_fan_mode(ClimateFanMode fan_mode) { fan_mode_ = fan_mode; return *this; }
+    ClimateCall &set_swing_mode(ClimateSwingMode swing_mode) { swing_mode_ = swing_mode; return *this; }
+    ClimateCall &set_preset(ClimatePreset preset) { preset_ = preset; return *this; }
+    void perform();
+
+    const optional<ClimateMode> &get_mode() const { return mode_; }
+    const optional<float> &get_target_temperature() const { return target_temperature_; }
+    const optional<ClimateFanMode> &get_fan_mode() const { return fan_mode_; }
+    const optional<ClimateSwingMode> &get_swing_mode() const { return swing_mode_; }
+    const optional<ClimatePreset> &get_preset() const { return preset_; }
+
+private:
+    Climate *parent_;
+    optional<ClimateMode> mode_;
+    optional<float> target_temperature_;
+    optional<ClimateFanMode> fan_mode_;
+    optional<ClimateSwingMode> swing_mode_;
+    optional<ClimatePreset> preset_;
+};
+
+class Climate : public EntityBase
+{
+public:
+    ClimateCall make_call() { return ClimateCall(this); }
+    ClimateTraits get_traits() { return traits(); }
+    void add_on_state_callback(std::function<void(Climate &)> &&callback) { callbacks_.push_back(std::move(callback)); }
+
+    void publish_state()
+    {
+        for (auto &callback : callbacks_) {
+            callback(*this);
+        }
+    }
+
+    ClimateMode mode{CLIMATE_MODE_OFF};
+    float current_temperature{0.0f};
+    float target_temperature{0.0f};
+    optional<ClimateFanMode> fan_mode;
+    ClimateSwingMode swing_mode{CLIMATE_SWING_OFF};
+    optional<ClimatePreset> preset;
+
+protected:
+    friend ClimateCall;
+
+    virtual void control(const ClimateCall &call) = 0;
+    virtual ClimateTraits traits() = 0;
+    void dump_traits_(const char * /* tag */) {}
+
+private:
+    std::vector<std::function<void(Climate &)>> callbacks_;
+};
+
+inline void ClimateCall::perform()
+{
+    parent_->control(*this);
+}
+
+} // namespace esphome::climate
@@ -0,0 +1,28 @@
+#pragma once
+#include <cmath>
+#include <functional>
+#include <vector>
+#include "esphome/core/component.h"
+
+namespace esphome::sensor {
+
+class Sensor : public EntityBase
+{
+public:
+    void publish_state(float new_state)
+    {
+        state = new_state;
+        for (auto &callback : callbacks_) {
+            callback(new_state);
+        }
+    }
+
+    void add_on_state_callback(std::function<void(float)> &&callback) { callbacks_.push_back(std::move(callback)); }
+
+    float state{NAN};
+
+private:
+    std::vector<std::function<void(float)>> callbacks_;
+};
+
+} // namespace esphome::sensor
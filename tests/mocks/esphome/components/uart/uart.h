@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "esphome/core/component.h"
+
+namespace esphome::uart {
+
+enum UARTParityOptions
+{
+    UART_CONFIG_PARITY_NONE,
+    UART_CONFIG_PARITY_EVEN,
+    UART_CONFIG_PARITY_ODD,
+};
+
+// stands for UART driver, test puts bytes to be received and inspects bytes sent by device
+class UARTComponent
+{
+public:
+    void inject_rx(const uint8_t *data, size_t length) { rx_.insert(rx_.end(), data, data + length); }
+    void inject_rx(const std::vector<uint8_t> &data) { inject_rx(data.data(), data.size()); }
+    size_t get_rx_pending() const { return rx_.size(); }
+    const std::vector<uint8_t> &get_tx_data() const { return tx_; }
+    void clear_tx_data() { tx_.clear(); }
+
+    size_t available() const { return rx_.size(); }
+    bool read_array(uint8_t *data, size_t length);
+    void write_array(const uint8_t *data, size_t length) { tx_.insert(tx_.end(), data, data + length); }
+
+private:
+    std::deque<uint8_t> rx_;
+    std::vector<uint8_t> tx_;
+};
+
+class UARTDevice
+{
+public:
+    UARTDevice() = default;
+    UARTDevice(UARTComponent *parent) : parent_(parent) {}
+
+    void set_uart_parent(UARTComponent *parent) { parent_ = parent; }
+
+    int available() { return static_cast<int>(parent_->available()); }
+    bool read_array(uint8_t *data, size_t length) { return parent_->read_array(data, length); }
+    void write_array(const uint8_t *data, size_t length) { parent_->write_array(data, length); }
+    void flush() {}
+    void check_uart_settings(uint32_t /* baud_rate */, uint8_t /* stop_bits */ = 1, 
+        UARTParityOptions /* parity */ = UART_CONFIG_PARITY_NONE, uint8_t /* data_bits */ = 8) {}
+
+protected:
+    UARTComponent *parent_{nullptr};
+};
+
+} // namespace esphome::uart
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "esphome/core/component.h"
+
+namespace esphome {
+
+class Application
+{
+public:
+    void register_component(Component *component) { components_.push_back(component); }
+    void clear_components() { components_.clear(); }
+
+    void setup();
+    void loop();
+    uint32_t get_loop_component_start_time() const;
+
+private:
+    std::vector<Component *> components_;
+};
+
+extern Application App;
+
+} // namespace esphome
@@ -0,0 +1,13 @@
+#pragma once
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+template<typename... Ts> class Action
+{
+public:
+    virtual ~Action() = default;
+    virtual void play(const Ts &...x) = 0;
+};
+
+} // namespace esphome
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "esphome/core/optional.h"
+
+namespace esphome {
+
+namespace setup_priority {
+
+extern const float DATA;
+extern const float AFTER_WIFI;
+
+} // namespace setup_priority
+
+class Component
+{
+public:
+    virtual ~Component() = default;
+
+    virtual void setup() {}
+    virtual void loop() {}
+    virtual void dump_config() {}
+    virtual float get_setup_priority() const { return 0.0f; }
+
+    void enable_loop() { loop_enabled_ = true; }
+    void disable_loop() { loop_enabled_ = false; }
+    void enable_loop_soon_any_context() { pending_enable_loop_ = true; }
+    bool is_loop_enabled() const { return loop_enabled_; }
+
+    // runs scheduled functions which are due and then loop(), if it's enabled
+    void call_loop_(uint32_t now);
+
+protected:
+    void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);
+    bool cancel_interval(const std::string &name);
+    void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);
+    bool cancel_timeout(const std::string &name);
+
+private:
+    struct ScheduledFunction
+    {
+        std::string name;
+        uint32_t interval;
+        uint32_t next_time;
+        bool repeat;
+        std::function<void()> function;
+    };
+
+    void schedule_(const std::string &name, uint32_t delay, bool repeat, std::function<void()> &&f);
+    bool cancel_(const std::string &name, bool repeat);
+
+    std::vector<ScheduledFunction> scheduled_;
+    bool loop_enabled_{true};
+    std::atomic<bool> pending_enable_loop_{false};
+};
+
+class EntityBase
+{
+public:
+    EntityBase();
+
+    const std::string &get_name() const { return name_; }
+    void set_name(const std::string &name) { name_ = name; }
+    uint32_t get_object_id_hash() const { return object_id_hash_; }
+    void set_object_id_hash(uint32_t hash) { object_id_hash_ = hash; }
+
+private:
+    std::string name_;
+    uint32_t object_id_hash_;
+};
+
+} // namespace esphome
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+
+namespace esphome {
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+uint32_t arch_get_cpu_cycle_count();
+uint32_t arch_get_cpu_freq_hz();
+
+namespace mock {
+
+// time stands still unless test moves it, which makes every run deterministic
+void set_time_us(uint64_t time_us);
+void advance_time_ms(uint32_t ms);
+void advance_time_us(uint32_t us);
+
+} // namespace mock
+} // namespace esphome
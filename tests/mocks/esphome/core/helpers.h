@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "esphome/core/optional.h"
+
+namespace esphome {
+
+std::string format_hex(const uint8_t *data, size_t length);
+std::string format_hex_pretty(const uint8_t *data, size_t length, char separator = '.', bool show_length = true);
+
+template<typename T> class Parented
+{
+public:
+    Parented() {}
+    Parented(T *parent) : parent_(parent) {}
+
+    T *get_parent() const { return parent_; }
+    void set_parent(T *parent) { parent_ = parent; }
+
+protected:
+    T *parent_{nullptr};
+};
+
+} // namespace esphome
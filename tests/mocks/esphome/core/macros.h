@@ -0,0 +1,3 @@
+#pragma once
+
+#define VERSION_CODE(major, minor, patch) ((major) << 16 | (minor) << 8 | (patch))
@@ -0,0 +1,9 @@
+#pragma once
+#include <optional>
+
+namespace esphome {
+
+using std::optional;
+using std::nullopt;
+
+} // namespace esphome
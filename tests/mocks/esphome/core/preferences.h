@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace esphome {
+
+class ESPPreferenceObject
+{
+public:
+    ESPPreferenceObject() = default;
+    ESPPreferenceObject(uint32_t key, size_t length, bool in_flash) : key_(key), length_(length), in_flash_(in_flash), valid_(true) {}
+
+    template<typename T> bool save(const T *src) { return save_(reinterpret_cast<const uint8_t *>(src), sizeof(T)); }
+    template<typename T> bool load(T *dest) { return load_(reinterpret_cast<uint8_t *>(dest), sizeof(T)); }
+
+protected:
+    bool save_(const uint8_t *data, size_t length);
+    bool load_(uint8_t *data, size_t length) const;
+
+    uint32_t key_{0};
+    size_t length_{0};
+    bool in_flash_{false};
+    bool valid_{false};
+};
+
+class ESPPreferences
+{
+public:
+    template<typename T> ESPPreferenceObject make_preference(uint32_t type, bool in_flash = false)
+    {
+        return ESPPreferenceObject(type, sizeof(T), in_flash);
+    }
+};
+
+extern ESPPreferences *global_preferences;
+
+namespace mock {
+
+// contents of preferences survive component re-creation, which stands for reboot
+struct StoredPreference
+{
+    std::vector<uint8_t> data;
+    bool in_flash;
+    uint32_t writes;
+};
+
+std::map<uint32_t, StoredPreference> &get_stored_preferences();
+void clear_preferences();
+
+} // namespace mock
+} // namespace esphome
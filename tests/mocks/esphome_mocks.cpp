@@ -0,0 +1,292 @@
+#include "esphome/core/application.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+#include "esphome/components/uart/uart.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace esphome {
+
+namespace setup_priority {
+
+const float DATA = 600.0f;
+const float AFTER_WIFI = 200.0f;
+
+} // namespace setup_priority
+
+namespace {
+
+uint64_t g_time_us = 0;
+std::vector<mock::LogMessage> g_log_messages;
+std::map<uint32_t, mock::StoredPreference> g_preferences;
+uint32_t g_next_object_id_hash = 0x1000;
+
+bool is_log_printed()
+{
+    static const bool printed = std::getenv("JHS_AC_TEST_LOG") != nullptr;
+    return printed;
+}
+
+} // namespace
+
+Application App;
+ESPPreferences *global_preferences = new ESPPreferences();
+
+// clock
+
+uint32_t millis()
+{
+    return static_cast<uint32_t>(g_time_us / 1000);
+}
+
+uint32_t micros()
+{
+    return static_cast<uint32_t>(g_time_us);
+}
+
+void delay(uint32_t ms)
+{
+    mock::advance_time_ms(ms);
+}
+
+uint32_t arch_get_cpu_cycle_count()
+{
+    // profiler measures real host time, with one cycle per nanosecond
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+uint32_t arch_get_cpu_freq_hz()
+{
+    return 1000000000;
+}
+
+void mock::set_time_us(uint64_t time_us)
+{
+    g_time_us = time_us;
+}
+
+void mock::advance_time_ms(uint32_t ms)
+{
+    g_time_us += static_cast<uint64_t>(ms) * 1000;
+}
+
+void mock::advance_time_us(uint32_t us)
+{
+    g_time_us += us;
+}
+
+// logging
+
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...)
+{
+    char text[512];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    g_log_messages.push_back(mock::LogMessage{level, text});
+    if (is_log_printed()) {
+        std::printf("[%d][%s:%d]: %s\n", level, tag, line, text);
+    }
+}
+
+const std::vector<mock::LogMessage> &mock::get_log_messages()
+{
+    return g_log_messages;
+}
+
+uint32_t mock::count_log_messages(const char *substring)
+{
+    return static_cast<uint32_t>(std::count_if(g_log_messages.begin(), g_log_messages.end(),
+        [substring](const LogMessage &message) { return message.text.find(substring) != std::string::npos; }));
+}
+
+void mock::clear_log_messages()
+{
+    g_log_messages.clear();
+}
+
+// helpers
+
+std::string format_hex(const uint8_t *data, size_t length)
+{
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string result;
+    result.reserve(length * 2);
+    for (size_t i = 0; i < length; i++)
+    {
+        result += DIGITS[data[i] >> 4];
+        result += DIGITS[data[i] & 0x0F];
+    }
+    return result;
+}
+
+std::string format_hex_pretty(const uint8_t *data, size_t length, char separator, bool show_length)
+{
+    static const char DIGITS[] = "0123456789ABCDEF";
+    std::string result;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (i > 0 && separator != 0) {
+            result += separator;
+        }
+        result += DIGITS[data[i] >> 4];
+        result += DIGITS[data[i] & 0x0F];
+    }
+    if (show_length && length > 4) {
+        result += " (" + std::to_string(length) + ")";
+    }
+    return result;
+}
+
+// preferences
+
+bool ESPPreferenceObject::save_(const uint8_t *data, size_t length)
+{
+    if (!valid_ || length != length_) {
+        return false;
+    }
+    mock::StoredPreference &stored = g_preferences[key_];
+    stored.data.assign(data, data + length);
+    stored.in_flash = in_flash_;
+    stored.writes++;
+    return true;
+}
+
+bool ESPPreferenceObject::load_(uint8_t *data, size_t length) const
+{
+    auto it = g_preferences.find(key_);
+    if (!valid_ || it == g_preferences.end() || it->second.data.size() != length) {
+        return false;
+    }
+    std::memcpy(data, it->second.data.data(), length);
+    return true;
+}
+
+std::map<uint32_t, mock::StoredPreference> &mock::get_stored_preferences()
+{
+    return g_preferences;
+}
+
+void mock::clear_preferences()
+{
+    g_preferences.clear();
+}
+
+// components
+
+EntityBase::EntityBase() : object_id_hash_(g_next_object_id_hash++)
+{
+}
+
+void Component::set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f)
+{
+    schedule_(name, interval, true, std::move(f));
+}
+
+bool Component::cancel_interval(const std::string &name)
+{
+    return cancel_(name, true);
+}
+
+void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f)
+{
+    schedule_(name, timeout, false, std::move(f));
+}
+
+bool Component::cancel_timeout(const std::string &name)
+{
+    return cancel_(name, false);
+}
+
+void Component::schedule_(const std::string &name, uint32_t delay, bool repeat, std::function<void()> &&f)
+{
+    cancel_(name, repeat);
+    scheduled_.push_back(ScheduledFunction{name, delay, millis() + delay, repeat, std::move(f)});
+}
+
+bool Component::cancel_(const std::string &name, bool repeat)
+{
+    auto it = std::find_if(scheduled_.begin(), scheduled_.end(), [&](const ScheduledFunction &function) {
+        return function.name == name && function.repeat == repeat;
+    });
+    if (it == scheduled_.end()) {
+        return false;
+    }
+    scheduled_.erase(it);
+    return true;
+}
+
+void Component::call_loop_(uint32_t now)
+{
+    for (size_t i = 0; i < scheduled_.size(); i++)
+    {
+        if (static_cast<int32_t>(now - scheduled_[i].next_time) < 0) {
+            continue;
+        }
+        // function may schedule or cancel others, so it's called on a copy
+        auto function = scheduled_[i].function;
+        if (scheduled_[i].repeat) {
+            scheduled_[i].next_time = now + scheduled_[i].interval;
+        }
+        else {
+            scheduled_.erase(scheduled_.begin() + i--);
+        }
+        function();
+    }
+
+    if (pending_enable_loop_.exchange(false)) {
+        loop_enabled_ = true;
+    }
+    if (loop_enabled_) {
+        loop();
+    }
+}
+
+void Application::setup()
+{
+    std::stable_sort(components_.begin(), components_.end(), [](Component *a, Component *b) {
+        return a->get_setup_priority() > b->get_setup_priority();
+    });
+    for (Component *component : components_)
+    {
+        component->setup();
+        component->dump_config();
+    }
+}
+
+void Application::loop()
+{
+    const uint32_t now = millis();
+    for (Component *component : components_) {
+        component->call_loop_(now);
+    }
+}
+
+uint32_t Application::get_loop_component_start_time() const
+{
+    return millis();
+}
+
+// uart
+
+bool uart::UARTComponent::read_array(uint8_t *data, size_t length)
+{
+    if (length > rx_.size()) {
+        return false;
+    }
+    std::copy_n(rx_.begin(), length, data);
+    rx_.erase(rx_.begin(), rx_.begin() + length);
+    return true;
+}
+
+} // namespace esphome
@@ -0,0 +1,182 @@
+#include "test.h"
+#include "packet_parser.h"
+#include "legacy/legacy_packet_parser.h"
+#include <random>
+#include <vector>
+
+using namespace esphome::jhs_ac;
+using namespace jhs_ac_test;
+
+namespace {
+
+using Frame = std::vector<uint8_t>;
+
+constexpr uint32_t STREAMS_COUNT = 20000;
+
+Frame make_random_frame(std::mt19937 &random)
+{
+    Frame frame = {0xA5};
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < 15; i++)
+    {
+        frame.push_back(random() % 256);
+        sum += frame.back();
+    }
+    frame.push_back(sum % 256);
+    frame.push_back(0xF5);
+    return frame;
+}
+
+std::vector<Frame> parse_with_legacy_parser(const std::vector<uint8_t> &stream)
+{
+    std::vector<Frame> frames;
+    LegacyPacketParser parser;
+    for (uint8_t byte : stream)
+    {
+        parser.process_byte(byte);
+        if (parser.packet_ready())
+        {
+            uint8_t packet[32];
+            const uint32_t length = parser.read_packet(packet, sizeof(packet));
+            if (LegacyPacketParser::validate_checksum(packet)) {
+                frames.emplace_back(packet, packet + length);
+            }
+        }
+    }
+    return frames;
+}
+
+// stream is fed in chunks of random size, as UART delivers it
+std::vector<Frame> parse_with_feed(const std::vector<uint8_t> &stream, std::mt19937 &random, uint32_t max_chunk_size)
+{
+    std::vector<Frame> frames;
+    PacketParser parser;
+    uint32_t offset = 0;
+    while (offset < stream.size())
+    {
+        const uint32_t length = std::min<uint32_t>(stream.size() - offset, 1 + random() % max_chunk_size);
+        const uint32_t consumed = parser.feed(stream.data() + offset, length, [&](const uint8_t *packet, uint32_t packet_length) {
+            frames.emplace_back(packet, packet + packet_length);
+            return true;
+        });
+        offset += consumed;
+    }
+    return frames;
+}
+
+bool is_subsequence(const std::vector<Frame> &subsequence, const std::vector<Frame> &sequence)
+{
+    size_t position = 0;
+    for (const Frame &frame : subsequence)
+    {
+        while (position < sequence.size() && sequence[position] != frame) {
+            position++;
+        }
+        if (position == sequence.size()) {
+            return false;
+        }
+        position++;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(clean_stream_gives_same_frames_as_legacy_parser)
+{
+    std::mt19937 random(42);
+    for (uint32_t i = 0; i < STREAMS_COUNT; i++)
+    {
+        // noise between frames contains no start markers, so legacy parser is never misled by it
+        std::vector<uint8_t> stream;
+        const uint32_t frames_count = random() % 8;
+        for (uint32_t j = 0; j < frames_count; j++)
+        {
+            const uint32_t noise_length = random() % 4;
+            for (uint32_t k = 0; k < noise_length; k++) {
+                stream.push_back(0xA6 + random() % 0x50);
+            }
+            const Frame frame = make_random_frame(random);
+            stream.insert(stream.end(), frame.begin(), frame.end());
+        }
+
+        const std::vector<Frame> expected = parse_with_legacy_parser(stream);
+        EXPECT_EQ(expected.size(), frames_count);
+        EXPECT(parse_with_feed(stream, random, 40) == expected);
+        EXPECT(parse_with_feed(stream, random, 1) == expected);
+    }
+}
+
+TEST(noisy_stream_keeps_every_frame_of_legacy_parser)
+{
+    // parser resynchronizes from start marker inside rejected packet, so on noisy input 
+    // it may find frames which legacy one skipped, but never loses ones legacy parser found
+    std::mt19937 random(7);
+    uint32_t legacy_frames = 0;
+    uint32_t frames = 0;
+    for (uint32_t i = 0; i < STREAMS_COUNT; i++)
+    {
+        std::vector<uint8_t> stream;
+        const uint32_t length = random() % 300;
+        while (stream.size() < length)
+        {
+            const uint32_t event = random() % 10;
+            if (event == 0)
+            {
+                Frame frame = make_random_frame(random);
+                if (random() % 6 == 0) {
+                    frame[random() % frame.size()] ^= 1 << (random() % 8);
+                }
+                stream.insert(stream.end(), frame.begin(), frame.end());
+            }
+            else if (event < 3) {
+                stream.push_back(0xA5);
+            }
+            else if (event < 4) {
+                stream.push_back(0xF5);
+            }
+            else {
+                stream.push_back(random() % 256);
+            }
+        }
+
+        const std::vector<Frame> expected = parse_with_legacy_parser(stream);
+        const std::vector<Frame> parsed = parse_with_feed(stream, random, 40);
+        EXPECT(is_subsequence(expected, parsed));
+        EXPECT(parse_with_feed(stream, random, 1) == parsed);
+        for (const Frame &frame : parsed) {
+            EXPECT(frame.back() == 0xF5 && LegacyPacketParser::validate_checksum(frame.data()));
+        }
+        legacy_frames += expected.size();
+        frames += parsed.size();
+    }
+    EXPECT(legacy_frames > 0);
+    EXPECT(frames >= legacy_frames);
+}
+
+TEST(feed_stops_after_rejecting_callback)
+{
+    std::mt19937 random(3);
+    std::vector<uint8_t> stream;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        const Frame frame = make_random_frame(random);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+
+    // bytes after stopping frame are left to caller, and yield remaining frames on next call
+    PacketParser parser;
+    uint32_t frames = 0;
+    const uint32_t consumed = parser.feed(stream.data(), stream.size(), [&](const uint8_t *, uint32_t) {
+        frames++;
+        return false;
+    });
+    EXPECT_EQ(frames, 1u);
+    EXPECT_EQ(consumed, 18u);
+
+    parser.feed(stream.data() + consumed, stream.size() - consumed, [&](const uint8_t *, uint32_t) {
+        frames++;
+        return true;
+    });
+    EXPECT_EQ(frames, 3u);
+}
@@ -0,0 +1,136 @@
+#include "component_fixture.h"
+#include "esphome/core/log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+// Feeds generated UART streams through component built with pipeline profiler and prints
+// its report for every stream. Host cycle counter mock counts nanoseconds, so cycles/frame
+// column is the same as ns/frame here. Usage: pipeline_benchmark [frames per stream]
+
+using namespace jhs_ac_test;
+
+namespace {
+
+// every chunk is received by single loop iteration
+using Stream = std::vector<std::vector<uint8_t>>;
+
+std::vector<uint8_t> make_frame(uint32_t index)
+{
+    // ambient temperature changes every 10th report, as it does on real unit only from time to time
+    AirConditionerState state = make_state(true, 24);
+    state.temperature_ambient = 20 + (index / 10) % 10;
+    return make_state_frame(state);
+}
+
+Stream make_clean_stream(uint32_t frames)
+{
+    Stream stream;
+    for (uint32_t i = 0; i < frames; i++) {
+        stream.push_back(make_frame(i));
+    }
+    return stream;
+}
+
+Stream make_fragmented_stream(uint32_t frames, std::mt19937 &random)
+{
+    Stream stream;
+    std::uniform_int_distribution<size_t> chunk_size(1, 7);
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        const std::vector<uint8_t> frame = make_frame(i);
+        for (size_t offset = 0; offset < frame.size();)
+        {
+            const size_t size = std::min(chunk_size(random), frame.size() - offset);
+            stream.emplace_back(frame.begin() + offset, frame.begin() + offset + size);
+            offset += size;
+        }
+    }
+    return stream;
+}
+
+Stream make_noisy_stream(uint32_t frames, std::mt19937 &random)
+{
+    Stream stream;
+    std::uniform_int_distribution<uint32_t> noise_size(0, 8);
+    std::uniform_int_distribution<uint32_t> noise_byte(0, UINT8_MAX);
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        std::vector<uint8_t> chunk(noise_size(random));
+        for (uint8_t &byte : chunk) {
+            byte = static_cast<uint8_t>(noise_byte(random));
+        }
+        const std::vector<uint8_t> frame = make_frame(i);
+        chunk.insert(chunk.end(), frame.begin(), frame.end());
+        stream.push_back(std::move(chunk));
+    }
+    return stream;
+}
+
+Stream make_burst_stream(uint32_t frames)
+{
+    // backlog accumulated during stalled loop, followed by idle iterations which are
+    // enough to drain it through 128 bytes receive buffer
+    static constexpr uint32_t BURST_FRAMES = 16;
+    Stream stream;
+    for (uint32_t i = 0; i < frames; i += BURST_FRAMES)
+    {
+        std::vector<uint8_t> burst;
+        for (uint32_t j = i; j < std::min(frames, i + BURST_FRAMES); j++)
+        {
+            const std::vector<uint8_t> frame = make_frame(j);
+            burst.insert(burst.end(), frame.begin(), frame.end());
+        }
+        stream.push_back(std::move(burst));
+        stream.resize(stream.size() + 3);
+    }
+    return stream;
+}
+
+void run_stream(const char *name, const Stream &stream)
+{
+    ComponentFixture fixture;
+    fixture.component.set_profile_pipeline(true);
+    fixture.start();
+    mock::clear_log_messages();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const std::vector<uint8_t> &chunk : stream)
+    {
+        fixture.uart.inject_rx(chunk);
+        App.loop();
+        mock::advance_time_us(500);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // report is logged by component's own interval
+    mock::clear_log_messages();
+    mock::advance_time_ms(JhsAirConditioner::PROFILING_REPORT_INTERVAL_MS);
+    App.loop();
+
+    std::printf("%s: %zu chunks, %.0f ns per loop iteration\n", name, stream.size(),
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / stream.size());
+    for (const mock::LogMessage &message : mock::get_log_messages())
+    {
+        if (message.level == ESPHOME_LOG_LEVEL_INFO) {
+            std::printf("  %s\n", message.text.c_str());
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const uint32_t frames = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 20000;
+    std::mt19937 random(0x4A48);
+
+    // every stream must fit into single profiling report interval
+    run_stream("clean", make_clean_stream(frames));
+    run_stream("fragmented", make_fragmented_stream(frames, random));
+    run_stream("noise", make_noisy_stream(frames, random));
+    run_stream("bursts", make_burst_stream(frames));
+    return 0;
+}
@@ -0,0 +1,24 @@
+#include "test.h"
+#include "component_fixture.h"
+
+using namespace jhs_ac_test;
+
+TEST(profiling_report_is_logged_when_enabled)
+{
+    ComponentFixture fixture;
+    fixture.component.set_profile_pipeline(true);
+    fixture.start();
+    fixture.run(JhsAirConditioner::PROFILING_REPORT_INTERVAL_MS + 1000);
+
+    EXPECT_EQ(mock::count_log_messages("Receive pipeline profile"), 1u);
+    EXPECT_EQ(mock::count_log_messages("Receive pipeline profile: 0 bytes"), 0u);
+}
+
+TEST(profiling_is_disabled_by_default)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.run(JhsAirConditioner::PROFILING_REPORT_INTERVAL_MS + 1000);
+
+    EXPECT_EQ(mock::count_log_messages("Receive pipeline profile"), 0u);
+}
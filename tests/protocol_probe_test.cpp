@@ -0,0 +1,92 @@
+#include "test.h"
+#include "component_fixture.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+
+using namespace jhs_ac_test;
+
+namespace {
+
+constexpr uint32_t OBJECT_ID_HASH = 0x1234;
+
+} // namespace
+
+TEST(version_2_is_detected_and_saved_to_flash)
+{
+    mock::clear_preferences();
+    ComponentFixture fixture(OBJECT_ID_HASH);
+    fixture.simulator.set_protocol_version(2);
+    fixture.component.set_protocol_version(JhsAirConditioner::PROTOCOL_VERSION_AUTO);
+    fixture.start();
+    fixture.run(10000);
+
+    EXPECT_EQ(mock::count_log_messages("Detected protocol version 2"), 1u);
+    // probed setting is restored with detected version
+    EXPECT_EQ(fixture.component.target_temperature, 24.0f);
+
+    auto &preferences = mock::get_stored_preferences();
+    const auto preference = preferences.find(OBJECT_ID_HASH ^ JhsAirConditioner::PROTOCOL_PREFERENCE_KEY);
+    EXPECT(preference != preferences.end());
+    EXPECT(preference != preferences.end() && preference->second.in_flash);
+}
+
+TEST(saved_version_skips_detection)
+{
+    mock::clear_preferences();
+    {
+        ComponentFixture fixture(OBJECT_ID_HASH);
+        fixture.simulator.set_protocol_version(2);
+        fixture.component.set_protocol_version(JhsAirConditioner::PROTOCOL_VERSION_AUTO);
+        fixture.start();
+        fixture.run(10000);
+    }
+
+    ComponentFixture fixture(OBJECT_ID_HASH);
+    fixture.simulator.set_protocol_version(2);
+    fixture.component.set_protocol_version(JhsAirConditioner::PROTOCOL_VERSION_AUTO);
+    fixture.start();
+    EXPECT_EQ(mock::count_log_messages("Using previously detected protocol version 2"), 1u);
+
+    fixture.run(1500);
+    fixture.component.make_call().set_target_temperature(18.0f).perform();
+    fixture.run(2000);
+    EXPECT_EQ(fixture.component.target_temperature, 18.0f);
+}
+
+TEST(out_of_range_setting_stops_detection_at_once)
+{
+    mock::clear_preferences();
+    ComponentFixture fixture(OBJECT_ID_HASH);
+    fixture.component.set_protocol_version(JhsAirConditioner::PROTOCOL_VERSION_AUTO);
+    fixture.start();
+
+    // some units report zero setting while they are off
+    fixture.uart.inject_rx(make_state_frame(make_state(false, 0)));
+    fixture.run(50, false);
+
+    EXPECT_EQ(mock::count_log_messages("is out of valid range"), 1u);
+    EXPECT_EQ(mock::count_log_messages("falling back to version 1"), 1u);
+    EXPECT(fixture.uart.get_tx_data().empty());
+    EXPECT(mock::get_stored_preferences().empty());
+
+    // queued commands are no longer held
+    fixture.component.make_call().set_target_temperature(20.0f).perform();
+    fixture.run(200, false);
+    EXPECT_EQ(fixture.uart.get_tx_data().size(), AirConditionerCommand::PACKET_AC_COMMAND_SIZE);
+}
+
+TEST(probe_applied_after_timeout_is_credited_to_its_version)
+{
+    mock::clear_preferences();
+    ComponentFixture fixture(OBJECT_ID_HASH);
+    // version 1 probe is applied after response timeout, but before next state report
+    fixture.simulator.set_reaction_delay(3500);
+    fixture.simulator.set_report_interval(4000);
+    fixture.component.set_protocol_version(JhsAirConditioner::PROTOCOL_VERSION_AUTO);
+    fixture.start();
+    fixture.run(20000);
+
+    EXPECT_EQ(mock::count_log_messages("Detected protocol version 1"), 1u);
+    EXPECT_EQ(mock::count_log_messages("Detected protocol version 2"), 0u);
+    EXPECT_EQ(fixture.component.target_temperature, 24.0f);
+}
@@ -0,0 +1,68 @@
+#include "test.h"
+#include "component_fixture.h"
+#include "uart_capture.h"
+
+using namespace jhs_ac_test;
+
+namespace {
+
+std::vector<uint8_t> make_capture(const std::vector<std::vector<uint8_t>> &frames, uint32_t interval_ms = 0)
+{
+    CaptureRecorder recorder;
+    recorder.allocate(1024);
+    recorder.start(0);
+    for (uint32_t i = 0; i < frames.size(); i++) {
+        recorder.record(CaptureDirection::Received, frames[i].data(), frames[i].size(), (i + 1) * interval_ms);
+    }
+    return std::vector<uint8_t>(recorder.get_data(), recorder.get_data() + recorder.get_size());
+}
+
+uint32_t get_preference_writes()
+{
+    uint32_t writes = 0;
+    for (const auto &[key, preference] : mock::get_stored_preferences()) {
+        writes += preference.writes;
+    }
+    return writes;
+}
+
+} // namespace
+
+TEST(replayed_states_are_only_logged)
+{
+    ComponentFixture fixture;
+    fixture.component.set_persist_state(true);
+    fixture.component.set_state_save_delay(0);
+    fixture.start();
+    fixture.run(1500);
+    const uint32_t publishes = fixture.get_climate_publishes();
+    const uint32_t preference_writes = get_preference_writes();
+
+    const std::vector<uint8_t> replayed_frame = make_state_frame(make_state(true, 20));
+    fixture.component.start_replay(make_capture({replayed_frame, replayed_frame}), ReplaySpeed::Maximum);
+    fixture.run(1000);
+
+    EXPECT_EQ(mock::count_log_messages("Replayed AC state:"), 1u);
+    EXPECT_EQ(mock::count_log_messages("replay finished: 2 frames"), 1u);
+    EXPECT_EQ(fixture.get_climate_publishes(), publishes);
+    EXPECT_EQ(fixture.component.mode, climate::CLIMATE_MODE_OFF);
+    EXPECT_EQ(fixture.component.target_temperature, 24.0f);
+    EXPECT_EQ(get_preference_writes(), preference_writes);
+}
+
+TEST(uart_is_read_during_replay)
+{
+    ComponentFixture fixture;
+    fixture.start();
+    fixture.run(1500);
+
+    // replay with original timing lasts longer than AC needs to confirm control request through UART
+    const std::vector<std::vector<uint8_t>> frames(20, make_state_frame(make_state(true, 24)));
+    fixture.component.start_replay(make_capture(frames, 100), ReplaySpeed::Original);
+    fixture.component.make_call().set_target_temperature(20.0f).perform();
+    fixture.run(1500);
+
+    EXPECT_EQ(mock::count_log_messages("replay finished"), 0u);
+    EXPECT_EQ(mock::count_log_messages("Command 0x14 confirmed by AC"), 1u);
+    EXPECT_EQ(fixture.component.target_temperature, 20.0f);
+}
@@ -0,0 +1,125 @@
+#include "ac_state_view.h"
+#include "packet_parser.h"
+#include "uart_capture.h"
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+// Feeds received data of UART capture through parser and state decoder, the same way
+// component does it, and prints decoded states. Capture may be binary file or hex string,
+// as it's printed by jhs_ac.capture_dump action.
+// Usage: jhs_ac_replay <capture file> [--original] [--quiet]
+
+using namespace esphome::jhs_ac;
+
+namespace {
+
+std::vector<uint8_t> load_capture(const char *path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    // binary capture starts with magic itself, hex one with its digits
+    const bool hex = content.size() >= 4 && (std::memcmp(content.data(), "4A48", 4) == 0 || std::memcmp(content.data(), "4a48", 4) == 0);
+    if (!hex) {
+        return content;
+    }
+
+    // hex digits split into several lines, any other characters are skipped
+    std::vector<uint8_t> capture;
+    std::string digits;
+    for (uint8_t symbol : content)
+    {
+        if (!std::isxdigit(symbol)) {
+            continue;
+        }
+        digits += static_cast<char>(symbol);
+        if (digits.size() == 2)
+        {
+            capture.push_back(static_cast<uint8_t>(std::stoul(digits, nullptr, 16)));
+            digits.clear();
+        }
+    }
+    return capture;
+}
+
+uint32_t get_time_ms(std::chrono::steady_clock::time_point start)
+{
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "Usage: %s <capture file> [--original] [--quiet]\n", argv[0]);
+        return 1;
+    }
+
+    ReplaySpeed speed = ReplaySpeed::Maximum;
+    bool quiet = false;
+    for (int i = 2; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--original") == 0) {
+            speed = ReplaySpeed::Original;
+        }
+        else if (std::strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        }
+    }
+
+    const std::vector<uint8_t> capture = load_capture(argv[1]);
+    CaptureReplayer replayer;
+    const auto start = std::chrono::steady_clock::now();
+    if (!replayer.start(capture.data(), capture.size(), speed, get_time_ms(start)))
+    {
+        std::fprintf(stderr, "Capture has invalid format\n");
+        return 1;
+    }
+
+    PacketParser parser;
+    AirConditionerState state{};
+    uint32_t bytes = 0;
+    uint32_t frames = 0;
+    uint8_t data[128];
+    while (replayer.is_active())
+    {
+        const uint32_t current_time = get_time_ms(start);
+        const uint32_t data_size = replayer.read(data, sizeof(data), current_time);
+        if (data_size == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        bytes += data_size;
+        parser.feed(data, data_size, [&](const uint8_t *packet, uint32_t) {
+            const AirConditionerState previous_state = state;
+            AirConditionerStateView(packet).decode(state);
+            char line[256];
+            if (!quiet && state.format(frames > 0 ? &previous_state : nullptr, line, sizeof(line)) > 0) {
+                std::printf("%8u ms AC state:%s\n", current_time, line);
+            }
+            frames++;
+            return true;
+        });
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const double elapsed_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    std::printf("%u bytes, %u frames, %u checksum errors, %u resyncs, %u discarded bytes\n",
+        bytes, frames, parser.get_checksum_errors(), parser.get_resyncs(), parser.get_discarded_bytes());
+    if (speed == ReplaySpeed::Maximum && bytes > 0)
+    {
+        std::printf("%.0f ns total, %.1f ns/byte, %.1f ns/frame\n", elapsed_ns, elapsed_ns / bytes,
+            frames > 0 ? elapsed_ns / frames : 0.0);
+    }
+    return 0;
+}
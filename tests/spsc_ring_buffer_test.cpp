@@ -0,0 +1,155 @@
+#include "test.h"
+#include "spsc_ring_buffer.h"
+#include "ring_buffer.h"
+#include "packet_parser.h"
+#include "ac_simulator.h"
+#include "ac_state_view.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace esphome::jhs_ac;
+
+namespace {
+
+constexpr uint32_t STREAM_LENGTH = 4000000;
+constexpr uint32_t FRAMES_COUNT = 100000;
+
+// sequence number is carried by bytes which have no meaning for decoder
+std::vector<uint8_t> make_frame(uint32_t sequence)
+{
+    AirConditionerState state{};
+    state.byte_0A = sequence & 0xFF;
+    state.byte_0B = (sequence >> 8) & 0xFF;
+    state.byte_0C = (sequence >> 16) & 0xFF;
+    std::vector<uint8_t> frame(AirConditionerStateView::PACKET_SIZE);
+    AirConditionerSimulator::encode_state_report(state, frame.data());
+    return frame;
+}
+
+} // namespace
+
+TEST(bytes_pass_between_threads_in_order)
+{
+    // small capacity makes wrap around and full buffer frequent
+    SpscRingBuffer<uint8_t, 64> ring;
+    std::atomic<bool> failed(false);
+
+    std::thread producer([&]() {
+        std::mt19937 random(1);
+        uint32_t next = 0;
+        while (next < STREAM_LENGTH)
+        {
+            auto span = ring.write_span();
+            if (span.length == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            const uint32_t count = std::min({span.length, STREAM_LENGTH - next, 1 + static_cast<uint32_t>(random() % 48)});
+            for (uint32_t i = 0; i < count; i++) {
+                span.data[i] = static_cast<uint8_t>(next++ * 7);
+            }
+            ring.commit_write(count);
+        }
+    });
+
+    uint32_t expected = 0;
+    std::mt19937 random(2);
+    while (expected < STREAM_LENGTH && !failed)
+    {
+        auto span = ring.read_span();
+        if (span.length == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const uint32_t count = std::min(span.length, 1 + static_cast<uint32_t>(random() % 48));
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (span.data[i] != static_cast<uint8_t>(expected++ * 7)) {
+                failed = true;
+            }
+        }
+        ring.consume(count);
+    }
+
+    producer.join();
+    EXPECT(!failed);
+    EXPECT_EQ(expected, STREAM_LENGTH);
+    EXPECT(ring.is_empty());
+}
+
+TEST(frames_survive_reader_task_protocol)
+{
+    // producer drains "UART" into ring as reader task does, consumer moves data into
+    // loop buffer and parses it as loop does, every frame should arrive exactly once and in order
+    SpscRingBuffer<uint8_t, 1024> ring;
+    std::vector<uint8_t> uart;
+    for (uint32_t i = 0; i < FRAMES_COUNT; i++)
+    {
+        const std::vector<uint8_t> frame = make_frame(i);
+        uart.insert(uart.end(), frame.begin(), frame.end());
+    }
+
+    std::thread producer([&]() {
+        std::mt19937 random(3);
+        uint32_t offset = 0;
+        while (offset < uart.size())
+        {
+            // UART driver keeps data which didn't fit into ring until next poll
+            uint32_t available = std::min<uint32_t>(uart.size() - offset, 1 + random() % 128);
+            while (available > 0 && !ring.is_full())
+            {
+                auto span = ring.write_span();
+                const uint32_t count = std::min(available, span.length);
+                std::memcpy(span.data, uart.data() + offset, count);
+                ring.commit_write(count);
+                offset += count;
+                available -= count;
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    RingBuffer<uint8_t, 128> buffer;
+    PacketParser parser;
+    uint32_t frames = 0;
+    bool in_order = true;
+    while (frames < FRAMES_COUNT)
+    {
+        while (!ring.is_empty() && !buffer.is_full())
+        {
+            auto source = ring.read_span();
+            auto destination = buffer.write_span();
+            const uint32_t count = std::min(source.length, destination.length);
+            std::memcpy(destination.data, source.data, count);
+            ring.consume(count);
+            buffer.commit_write(count);
+        }
+        if (buffer.is_empty())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        while (!buffer.is_empty())
+        {
+            auto span = buffer.read_span();
+            buffer.consume(parser.feed(span.data, span.length, [&](const uint8_t *packet, uint32_t) {
+                const AirConditionerStateView view(packet);
+                const uint32_t sequence = view.byte_0A() | (view.byte_0B() << 8) | (view.byte_0C() << 16);
+                in_order = in_order && sequence == frames;
+                frames++;
+                return true;
+            }));
+        }
+    }
+
+    producer.join();
+    EXPECT(in_order);
+    EXPECT_EQ(frames, FRAMES_COUNT);
+    EXPECT_EQ(parser.get_checksum_errors(), 0u);
+}
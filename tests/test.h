@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// minimal test runner, so host tests don't depend on anything beyond compiler
+namespace jhs_ac_test {
+
+struct TestCase
+{
+    const char *name;
+    void (*function)();
+};
+
+std::vector<TestCase> &get_test_cases();
+void report_failure(const char *file, int line, const char *expression);
+
+struct TestRegistrar
+{
+    TestRegistrar(const char *name, void (*function)()) { get_test_cases().push_back(TestCase{name, function}); }
+};
+
+} // namespace jhs_ac_test
+
+#define TEST(name) \
+    static void name(); \
+    static ::jhs_ac_test::TestRegistrar name##_registrar(#name, name); \
+    static void name()
+
+#define EXPECT(expression) \
+    do { \
+        if (!(expression)) { \
+            ::jhs_ac_test::report_failure(__FILE__, __LINE__, #expression); \
+        } \
+    } while (false)
+
+#define EXPECT_EQ(actual, expected) EXPECT((actual) == (expected))
@@ -0,0 +1,43 @@
+#include "test.h"
+#include <cstring>
+
+namespace jhs_ac_test {
+
+namespace {
+
+uint32_t g_failures = 0;
+
+} // namespace
+
+std::vector<TestCase> &get_test_cases()
+{
+    static std::vector<TestCase> test_cases;
+    return test_cases;
+}
+
+void report_failure(const char *file, int line, const char *expression)
+{
+    std::printf("%s:%d: expectation failed: %s\n", file, line, expression);
+    g_failures++;
+}
+
+} // namespace jhs_ac_test
+
+int main(int argc, char **argv)
+{
+    // optional argument selects tests which names contain it
+    const char *filter = argc > 1 ? argv[1] : nullptr;
+    uint32_t failed_tests = 0;
+    for (const auto &test_case : jhs_ac_test::get_test_cases())
+    {
+        if (filter && std::strstr(test_case.name, filter) == nullptr) {
+            continue;
+        }
+        const uint32_t failures = jhs_ac_test::g_failures;
+        test_case.function();
+        const bool passed = jhs_ac_test::g_failures == failures;
+        std::printf("[%s] %s\n", passed ? "PASS" : "FAIL", test_case.name);
+        failed_tests += passed ? 0 : 1;
+    }
+    return failed_tests == 0 ? 0 : 1;
+}